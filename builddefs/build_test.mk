@@ -4,7 +4,11 @@ endif
 
 .DEFAULT_GOAL := all
 
+ifeq ($(strip $(BENCH)), yes)
+OPT = 2
+else
 OPT = g
+endif
 
 include paths.mk
 include $(BUILDDEFS_PATH)/message.mk
@@ -53,13 +57,20 @@ endif
 
 ifneq ($(filter $(FULL_TESTS),$(TEST)),)
 include tests/test_common/build.mk
+ifeq ($(strip $(BENCH)), yes)
+include tests/bench/bench_common/build.mk
+include $(TEST_PATH)/bench.mk
+else
 include $(TEST_PATH)/test.mk
 endif
+endif
 
 include $(BUILDDEFS_PATH)/common_features.mk
 include $(BUILDDEFS_PATH)/generic_features.mk
 include $(PLATFORM_PATH)/common.mk
 include $(TMK_PATH)/protocol.mk
+include $(DRIVER_PATH)/bluetooth/tests/rules.mk
+include $(QUANTUM_PATH)/audio/tests/rules.mk
 include $(QUANTUM_PATH)/debounce/tests/rules.mk
 include $(QUANTUM_PATH)/encoder/tests/rules.mk
 include $(QUANTUM_PATH)/os_detection/tests/rules.mk
@@ -71,9 +82,12 @@ ifneq ($(filter $(FULL_TESTS),$(TEST)),)
 include $(BUILDDEFS_PATH)/build_full_test.mk
 endif
 
-$(TEST)_SRC += \
-	tests/test_common/main.cpp \
-	$(QUANTUM_PATH)/logging/print.c
+$(TEST)_SRC += $(QUANTUM_PATH)/logging/print.c
+
+# libFuzzer brings its own main()
+ifneq ($(strip $(FUZZ_ENGINE)), libfuzzer)
+$(TEST)_SRC += tests/test_common/main.cpp
+endif
 
 ifneq ($(strip $(INTROSPECTION_KEYMAP_C)),)
 $(TEST)_DEFS += -DINTROSPECTION_KEYMAP_C=\"$(strip $(INTROSPECTION_KEYMAP_C))\"
@@ -29,6 +29,7 @@ GENERIC_FEATURES = \
     GRAVE_ESC \
     HAPTIC \
     KEY_LOCK \
+    KEYSTROKE_TRACE \
     KEY_OVERRIDE \
     LEADER \
     PROGRAMMABLE_BUTTON \
@@ -42,6 +42,7 @@ OTHER_OPTION_NAMES = \
   COMBO_ENABLE \
   KEY_LOCK_ENABLE \
   KEY_OVERRIDE_ENABLE \
+  KEYSTROKE_TRACE_ENABLE \
   LEADER_ENABLE \
   STENO_ENABLE \
   STENO_PROTOCOL \
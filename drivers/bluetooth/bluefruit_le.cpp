@@ -7,6 +7,7 @@
 #include "timer.h"
 #include "gpio.h"
 #include "ringbuffer.hpp"
+#include "bluefruit_le_keys.h"
 #include <string.h>
 #include "spi_master.h"
 #include "wait.h"
@@ -32,6 +33,11 @@
 #    define BLUEFRUIT_LE_SCK_DIVISOR 2 // 4MHz SCK/8MHz CPU, calculated for Feather 32U4 BLE
 #endif
 
+// Maximum number of AT commands sent without having received their responses
+#ifndef BLUEFRUIT_LE_MAX_PENDING_RESPONSES
+#    define BLUEFRUIT_LE_MAX_PENDING_RESPONSES 4
+#endif
+
 #define SAMPLE_BATTERY
 #define ConnectionUpdateInterval 1000 /* milliseconds */
 
@@ -53,6 +59,8 @@ static struct {
     uint32_t vbat;
 #endif
     uint16_t last_connection_update;
+    uint16_t last_send_failure;
+    bool     send_backoff;
 } state;
 
 // Commands are encoded using SDEP and sent via SPI
@@ -86,10 +94,7 @@ struct queue_item {
     enum queue_type queue_type;
     uint16_t        added;
     union __attribute__((packed)) {
-        struct __attribute__((packed)) {
-            uint8_t modifier;
-            uint8_t keys[6];
-        } key;
+        struct key_state key;
 
         uint16_t consumer;
         struct __attribute__((packed)) {
@@ -101,10 +106,16 @@ struct queue_item {
 
 // Items that we wish to send
 static RingBuffer<queue_item, 40> send_buf;
-// Pending response; while pending, we can't send any more requests.
-// This records the time at which we sent the command for which we
-// are expecting a response.
-static RingBuffer<uint16_t, 2> resp_buf;
+// Pending responses; commands are pipelined, so up to
+// BLUEFRUIT_LE_MAX_PENDING_RESPONSES commands may be sent before their
+// responses are read back.  This records the time at which we sent each
+// command for which we are expecting a response.
+static RingBuffer<uint16_t, BLUEFRUIT_LE_MAX_PENDING_RESPONSES + 1> resp_buf;
+
+// The most recently queued keyboard report, and the one before it.  These
+// are used to decide whether a new report can be merged into the queue
+// without losing a keypress.
+static struct key_state last_key_queued, key_before_last_queued;
 
 static bool process_queue_item(struct queue_item *item, uint16_t timeout);
 
@@ -255,25 +266,47 @@ static void resp_buf_read_one(bool greedy) {
     }
 }
 
+// Number of AT commands (and so responses) needed to send an item
+static inline uint8_t queue_item_command_count(const struct queue_item *item) {
+    return item->queue_type == QTMouseMove ? 2 : 1;
+}
+
 static void send_buf_send_one(uint16_t timeout = SdepTimeout) {
     struct queue_item item;
 
-    // Don't send anything more until we get an ACK
-    if (!resp_buf.empty()) {
-        return;
+    // Back off for a while after a failure, without stalling the matrix loop
+    if (state.send_backoff) {
+        if (timer_elapsed(state.last_send_failure) < SdepTimeout) {
+            return;
+        }
+        state.send_backoff = false;
     }
 
     if (!send_buf.peek(item)) {
         return;
     }
+
+    // Don't send anything more until there is room to track its responses
+    if (resp_buf.capacity() - resp_buf.size() < queue_item_command_count(&item)) {
+        return;
+    }
+
     if (process_queue_item(&item, timeout)) {
         // commit that peek
         send_buf.get(item);
         dprintf("send_buf_send_one: have %d remaining\n", (int)send_buf.size());
     } else {
         dprint("failed to send, will retry\n");
-        wait_ms(SdepTimeout);
+        state.last_send_failure = timer_read();
+        state.send_backoff      = true;
+    }
+}
+
+// Make room in the send queue, servicing responses as they arrive
+static void send_buf_enqueue(const struct queue_item &item) {
+    while (!send_buf.enqueue(item)) {
         resp_buf_read_one(true);
+        send_buf_send_one();
     }
 }
 
@@ -506,7 +539,11 @@ void bluefruit_le_task(void) {
         return;
     }
     resp_buf_read_one(true);
-    send_buf_send_one(SdepShortTimeout);
+    // Pipeline queued items, as long as there is room for their responses
+    uint8_t pending = send_buf.size();
+    while (pending-- > 0 && !state.send_backoff && !resp_buf.full()) {
+        send_buf_send_one(SdepShortTimeout);
+    }
 
     if (resp_buf.empty() && (state.event_flags & UsingEvents) && readPin(BLUEFRUIT_LE_IRQ_PIN)) {
         // Must be an event update
@@ -624,9 +661,19 @@ void bluefruit_le_send_keyboard(report_keyboard_t *report) {
     item.key.keys[4]  = report->keys[4];
     item.key.keys[5]  = report->keys[5];
 
-    while (!send_buf.enqueue(item)) {
-        send_buf_send_one();
+    // If the last queued report hasn't been sent yet, replace it with the latest state,
+    // as long as that doesn't hide a keypress or release, or change the modifiers it was sent with
+    if (!send_buf.empty() && send_buf.back().queue_type == QTKeyReport) {
+        if (key_state_can_merge(&key_before_last_queued, &last_key_queued, &item.key)) {
+            memcpy(&send_buf.back().key, &item.key, sizeof(item.key));
+            memcpy(&last_key_queued, &item.key, sizeof(last_key_queued));
+            return;
+        }
     }
+
+    memcpy(&key_before_last_queued, &last_key_queued, sizeof(key_before_last_queued));
+    memcpy(&last_key_queued, &item.key, sizeof(last_key_queued));
+    send_buf_enqueue(item);
 }
 
 void bluefruit_le_send_consumer(uint16_t usage) {
@@ -635,9 +682,16 @@ void bluefruit_le_send_consumer(uint16_t usage) {
     item.queue_type = QTConsumer;
     item.consumer   = usage;
 
-    while (!send_buf.enqueue(item)) {
-        send_buf_send_one();
+    send_buf_enqueue(item);
+}
+
+static inline bool merge_mouse_delta(int8_t *dest, int8_t delta) {
+    int16_t sum = *dest + delta;
+    if (sum < INT8_MIN || sum > INT8_MAX) {
+        return false;
     }
+    *dest = sum;
+    return true;
 }
 
 void bluefruit_le_send_mouse(report_mouse_t *report) {
@@ -650,9 +704,17 @@ void bluefruit_le_send_mouse(report_mouse_t *report) {
     item.mousemove.pan     = report->h;
     item.mousemove.buttons = report->buttons;
 
-    while (!send_buf.enqueue(item)) {
-        send_buf_send_one();
+    // Accumulate movement into the last queued report if it hasn't been sent yet and the buttons haven't changed
+    if (!send_buf.empty() && send_buf.back().queue_type == QTMouseMove && send_buf.back().mousemove.buttons == item.mousemove.buttons) {
+        struct queue_item &last   = send_buf.back();
+        auto               merged = last.mousemove;
+        if (merge_mouse_delta(&merged.x, item.mousemove.x) && merge_mouse_delta(&merged.y, item.mousemove.y) && merge_mouse_delta(&merged.scroll, item.mousemove.scroll) && merge_mouse_delta(&merged.pan, item.mousemove.pan)) {
+            last.mousemove = merged;
+            return;
+        }
     }
+
+    send_buf_enqueue(item);
 }
 
 uint32_t bluefruit_le_read_battery_voltage(void) {
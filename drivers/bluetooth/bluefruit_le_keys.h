@@ -0,0 +1,38 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+// Modifiers and keys of a queued keyboard report
+struct key_state {
+    uint8_t modifier;
+    uint8_t keys[6];
+};
+
+static inline bool key_state_has(const struct key_state *state, uint8_t key) {
+    return memchr(state->keys, key, sizeof(state->keys)) != NULL;
+}
+
+/* Whether the last queued report, still unsent, can be replaced by `next`
+ * without the host missing anything: the modifiers must be the same, the keys
+ * it pressed must still be down, and the keys it released must still be up. */
+static inline bool key_state_can_merge(const struct key_state *before_last, const struct key_state *last, const struct key_state *next) {
+    if (last->modifier != next->modifier) {
+        return false;
+    }
+    for (uint8_t i = 0; i < 6; ++i) {
+        uint8_t key = last->keys[i];
+        if (key != 0 && !key_state_has(before_last, key) && !key_state_has(next, key)) {
+            return false;
+        }
+        key = next->keys[i];
+        if (key != 0 && key_state_has(before_last, key) && !key_state_has(last, key)) {
+            return false;
+        }
+    }
+    return true;
+}
@@ -48,6 +48,10 @@ class RingBuffer {
 
   inline bool empty() const { return head_ == tail_; }
 
+  inline bool full() const { return size() == capacity(); }
+
+  inline uint8_t capacity() const { return Size - 1; }
+
   inline uint8_t size() const {
     int diff = head_ - tail_;
     if (diff >= 0) {
@@ -60,6 +64,11 @@ class RingBuffer {
     return buf_[tail_];
   }
 
+  // The most recently enqueued item; only valid when !empty()
+  inline T& back() {
+    return buf_[prevPosition(head_)];
+  }
+
   inline bool peek(T &item) {
     return get(item, false);
   }
@@ -0,0 +1,47 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "bluefruit_le_keys.h"
+}
+
+// HID usages of A and B, and the left shift modifier bit
+#define A 0x04
+#define B 0x05
+#define SHIFT 0x02
+
+static const key_state none    = {0, {0}};
+static const key_state a       = {0, {A}};
+static const key_state b       = {0, {B}};
+static const key_state ab      = {0, {A, B}};
+static const key_state ba      = {0, {B, A}};
+static const key_state shift_a = {SHIFT, {A}};
+
+TEST(BluefruitLeKeys, MergesWhenNothingIsLost) {
+    // A held, then B pressed and A released: B is still down
+    EXPECT_TRUE(key_state_can_merge(&a, &ab, &b));
+    // B pressed then more keys or the same state again
+    EXPECT_TRUE(key_state_can_merge(&none, &b, &ba));
+    EXPECT_TRUE(key_state_can_merge(&none, &a, &a));
+    // A release followed by another release
+    EXPECT_TRUE(key_state_can_merge(&ab, &b, &none));
+}
+
+TEST(BluefruitLeKeys, KeepsPresses) {
+    // A tapped: the press has to reach the host before the release
+    EXPECT_FALSE(key_state_can_merge(&none, &a, &none));
+    EXPECT_FALSE(key_state_can_merge(&b, &ab, &b));
+}
+
+TEST(BluefruitLeKeys, KeepsReleases) {
+    // A pressed, released and pressed again: the host has to see two presses
+    EXPECT_FALSE(key_state_can_merge(&a, &none, &a));
+    EXPECT_FALSE(key_state_can_merge(&ab, &b, &ba));
+}
+
+TEST(BluefruitLeKeys, KeepsModifiers) {
+    EXPECT_FALSE(key_state_can_merge(&none, &a, &shift_a));
+    EXPECT_FALSE(key_state_can_merge(&none, &shift_a, &a));
+}
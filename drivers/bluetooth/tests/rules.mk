@@ -0,0 +1,4 @@
+bluefruit_le_keys_INC := $(DRIVER_PATH)/bluetooth
+
+bluefruit_le_keys_SRC := \
+    $(DRIVER_PATH)/bluetooth/tests/bluefruit_le_keys_tests.cpp
@@ -0,0 +1 @@
+TEST_LIST += bluefruit_le_keys
@@ -50,11 +50,23 @@ void eeprom_write_dword(uint32_t *addr, uint32_t value) {
 }
 
 void eeprom_update_block(const void *buf, void *addr, size_t len) {
-    uint8_t read_buf[len];
+    const uint8_t *new_buf = (const uint8_t *)buf;
+    uint8_t        read_buf[len];
     eeprom_read_block(read_buf, addr, len);
-    if (memcmp(buf, read_buf, len) != 0) {
-        eeprom_write_block(buf, addr, len);
+
+    // Only write the span between the first and last modified bytes, so a bulk update becomes as few page writes as possible
+    size_t first = 0;
+    while (first < len && new_buf[first] == read_buf[first]) {
+        ++first;
+    }
+    if (first == len) {
+        return;
+    }
+    size_t last = len - 1;
+    while (new_buf[last] == read_buf[last]) {
+        --last;
     }
+    eeprom_write_block(&new_buf[first], (uint8_t *)addr + first, last - first + 1);
 }
 
 void eeprom_update_byte(uint8_t *addr, uint8_t value) {
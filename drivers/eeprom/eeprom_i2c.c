@@ -15,6 +15,7 @@
  */
 
 #include <stdint.h>
+#include <stdbool.h>
 #include <string.h>
 #if defined(EXTERNAL_EEPROM_WP_PIN)
 #    include "gpio.h"
@@ -34,6 +35,7 @@
 */
 
 #include "wait.h"
+#include "timer.h"
 #include "i2c_master.h"
 #include "eeprom.h"
 #include "eeprom_i2c.h"
@@ -41,10 +43,25 @@
 // #define DEBUG_EEPROM_OUTPUT
 
 #if defined(CONSOLE_ENABLE) && defined(DEBUG_EEPROM_OUTPUT)
-#    include "timer.h"
 #    include "debug.h"
 #endif // DEBUG_EEPROM_OUTPUT
 
+/*
+    Number of bytes addressable through the memory address bytes alone. Any
+    remaining address bits are carried in the device address, so sequential
+    reads must not cross this boundary.
+*/
+#if EXTERNAL_EEPROM_ADDRESS_SIZE < 4
+#    define EXTERNAL_EEPROM_BANK_SIZE (1UL << (8 * EXTERNAL_EEPROM_ADDRESS_SIZE))
+#else
+#    define EXTERNAL_EEPROM_BANK_SIZE (SIZE_MAX)
+#endif
+
+#if EXTERNAL_EEPROM_WRITE_TIME > 0
+// Set after a page write has been issued, until the device acknowledges its address again.
+static bool write_pending = false;
+#endif
+
 static inline void fill_target_address(uint8_t *buffer, const void *addr) {
     uintptr_t p = (uintptr_t)addr;
     for (int i = 0; i < EXTERNAL_EEPROM_ADDRESS_SIZE; ++i) {
@@ -53,6 +70,51 @@ static inline void fill_target_address(uint8_t *buffer, const void *addr) {
     }
 }
 
+/*
+    Waits for a previously issued page write to complete.
+
+    24xx-series parts do not acknowledge their device address while the
+    internal write cycle is in progress, so the device is polled until it ACKs
+    instead of always waiting for the worst-case write time. The datasheet
+    write time still bounds the wait, in case the device never responds.
+*/
+static void i2c_eeprom_wait_while_busy(uintptr_t addr) {
+#if EXTERNAL_EEPROM_WRITE_TIME > 0
+    if (!write_pending) {
+        return;
+    }
+
+    uint8_t  complete_packet[EXTERNAL_EEPROM_ADDRESS_SIZE];
+    uint32_t start = timer_read32();
+    fill_target_address(complete_packet, (const void *)addr);
+    while (i2c_transmit(EXTERNAL_EEPROM_I2C_ADDRESS(addr), complete_packet, EXTERNAL_EEPROM_ADDRESS_SIZE, 100) != I2C_STATUS_SUCCESS) {
+        if (timer_elapsed32(start) > EXTERNAL_EEPROM_WRITE_TIME) {
+            break;
+        }
+    }
+    write_pending = false;
+#else
+    (void)addr;
+#endif
+}
+
+static i2c_status_t i2c_eeprom_read_sequential(uintptr_t addr, uint8_t *buf, uint16_t len) {
+    uint8_t devaddr = EXTERNAL_EEPROM_I2C_ADDRESS(addr);
+#if EXTERNAL_EEPROM_ADDRESS_SIZE == 1
+    return i2c_readReg(devaddr, addr & 0xFF, buf, len, 100);
+#elif EXTERNAL_EEPROM_ADDRESS_SIZE == 2
+    return i2c_readReg16(devaddr, addr & 0xFFFF, buf, len, 100);
+#else
+    uint8_t complete_packet[EXTERNAL_EEPROM_ADDRESS_SIZE];
+    fill_target_address(complete_packet, (const void *)addr);
+    i2c_status_t status = i2c_transmit(devaddr, complete_packet, EXTERNAL_EEPROM_ADDRESS_SIZE, 100);
+    if (status != I2C_STATUS_SUCCESS) {
+        return status;
+    }
+    return i2c_receive(devaddr, buf, len, 100);
+#endif
+}
+
 void eeprom_driver_init(void) {
     i2c_init();
 #if defined(EXTERNAL_EEPROM_WP_PIN)
@@ -79,15 +141,34 @@ void eeprom_driver_erase(void) {
 }
 
 void eeprom_read_block(void *buf, const void *addr, size_t len) {
-    uint8_t complete_packet[EXTERNAL_EEPROM_ADDRESS_SIZE];
-    fill_target_address(complete_packet, addr);
+    uint8_t * target      = (uint8_t *)buf;
+    uintptr_t source_addr = (uintptr_t)addr;
+
+    i2c_eeprom_wait_while_busy(source_addr);
+
+    // Each chunk is a single address-write plus repeated-start read; chunks only split at device bank boundaries.
+    while (len > 0) {
+        size_t read_length = EXTERNAL_EEPROM_BANK_SIZE - (source_addr % EXTERNAL_EEPROM_BANK_SIZE);
+        if (read_length > len) {
+            read_length = len;
+        }
+        if (read_length > UINT16_MAX) {
+            read_length = UINT16_MAX;
+        }
+
+        if (i2c_eeprom_read_sequential(source_addr, target, read_length) != I2C_STATUS_SUCCESS) {
+            memset(target, 0, len);
+            return;
+        }
 
-    i2c_transmit(EXTERNAL_EEPROM_I2C_ADDRESS((uintptr_t)addr), complete_packet, EXTERNAL_EEPROM_ADDRESS_SIZE, 100);
-    i2c_receive(EXTERNAL_EEPROM_I2C_ADDRESS((uintptr_t)addr), buf, len, 100);
+        target += read_length;
+        source_addr += read_length;
+        len -= read_length;
+    }
 
 #if defined(CONSOLE_ENABLE) && defined(DEBUG_EEPROM_OUTPUT)
     dprintf("[EEPROM R] 0x%04X: ", ((int)addr));
-    for (size_t i = 0; i < len; ++i) {
+    for (size_t i = 0; i < (size_t)(target - (uint8_t *)buf); ++i) {
         dprintf(" %02X", (int)(((uint8_t *)buf)[i]));
     }
     dprintf("\n");
@@ -124,8 +205,11 @@ void eeprom_write_block(const void *buf, void *addr, size_t len) {
         dprintf("\n");
 #endif // DEBUG_EEPROM_OUTPUT
 
-        i2c_transmit(EXTERNAL_EEPROM_I2C_ADDRESS((uintptr_t)addr), complete_packet, EXTERNAL_EEPROM_ADDRESS_SIZE + write_length, 100);
-        wait_ms(EXTERNAL_EEPROM_WRITE_TIME);
+        i2c_eeprom_wait_while_busy(target_addr);
+        i2c_transmit(EXTERNAL_EEPROM_I2C_ADDRESS(target_addr), complete_packet, EXTERNAL_EEPROM_ADDRESS_SIZE + write_length, 100);
+#if EXTERNAL_EEPROM_WRITE_TIME > 0
+        write_pending = true;
+#endif
 
         read_buf += write_length;
         target_addr += write_length;
@@ -133,6 +217,9 @@ void eeprom_write_block(const void *buf, void *addr, size_t len) {
     }
 
 #if defined(EXTERNAL_EEPROM_WP_PIN)
+    /* The write cycle must complete before write protection is re-enabled */
+    i2c_eeprom_wait_while_busy((uintptr_t)addr);
+
     /* We are setting the WP pin to high in a way that requires at least two bit-flips to change back to 0 */
     writePin(EXTERNAL_EEPROM_WP_PIN, 1);
     setPinInputHigh(EXTERNAL_EEPROM_WP_PIN);
@@ -118,7 +118,9 @@
 
 /*
     The write cycle time of the EEPROM in milliseconds, as specified in the
-    datasheet.
+    datasheet. Completion of a write is detected by polling for an ACK, so
+    this is only used as an upper bound -- set to 0 for parts without a write
+    cycle, such as FRAM.
 */
 #ifndef EXTERNAL_EEPROM_WRITE_TIME
 #    define EXTERNAL_EEPROM_WRITE_TIME 5
@@ -45,6 +45,28 @@ uint32_t qp_comms_spi_send_data(painter_device_t device, const void *data, uint3
     return byte_count - bytes_remaining;
 }
 
+#    ifdef SPI_TRANSMIT_ASYNC_SUPPORTED
+
+static painter_async_complete_func async_callback = NULL;
+static void *                      async_cb_arg   = NULL;
+
+static void qp_comms_spi_send_data_async_complete(void) {
+    async_callback(async_cb_arg);
+}
+
+bool qp_comms_spi_send_data_async(painter_device_t device, const void *data, uint32_t byte_count, painter_async_complete_func callback, void *cb_arg) {
+    // A single DMA transfer is limited to 16-bit lengths, larger transfers go through the blocking path
+    if (byte_count > UINT16_MAX) {
+        return false;
+    }
+
+    async_callback = callback;
+    async_cb_arg   = cb_arg;
+    return spi_transmit_async((const uint8_t *)data, byte_count, qp_comms_spi_send_data_async_complete) == SPI_STATUS_SUCCESS;
+}
+
+#    endif // SPI_TRANSMIT_ASYNC_SUPPORTED
+
 void qp_comms_spi_stop(painter_device_t device) {
     painter_driver_t *     driver       = (painter_driver_t *)device;
     qp_comms_spi_config_t *comms_config = (qp_comms_spi_config_t *)driver->comms_config;
@@ -57,6 +79,9 @@ const painter_comms_vtable_t spi_comms_vtable = {
     .comms_start = qp_comms_spi_start,
     .comms_send  = qp_comms_spi_send_data,
     .comms_stop  = qp_comms_spi_stop,
+#    ifdef SPI_TRANSMIT_ASYNC_SUPPORTED
+    .comms_send_async = qp_comms_spi_send_data_async,
+#    endif // SPI_TRANSMIT_ASYNC_SUPPORTED
 };
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -97,6 +122,15 @@ uint32_t qp_comms_spi_dc_reset_send_data(painter_device_t device, const void *da
     return qp_comms_spi_send_data(device, data, byte_count);
 }
 
+#        ifdef SPI_TRANSMIT_ASYNC_SUPPORTED
+bool qp_comms_spi_dc_reset_send_data_async(painter_device_t device, const void *data, uint32_t byte_count, painter_async_complete_func callback, void *cb_arg) {
+    painter_driver_t *              driver       = (painter_driver_t *)device;
+    qp_comms_spi_dc_reset_config_t *comms_config = (qp_comms_spi_dc_reset_config_t *)driver->comms_config;
+    writePinHigh(comms_config->dc_pin);
+    return qp_comms_spi_send_data_async(device, data, byte_count, callback, cb_arg);
+}
+#        endif // SPI_TRANSMIT_ASYNC_SUPPORTED
+
 void qp_comms_spi_dc_reset_send_command(painter_device_t device, uint8_t cmd) {
     painter_driver_t *              driver       = (painter_driver_t *)device;
     qp_comms_spi_dc_reset_config_t *comms_config = (qp_comms_spi_dc_reset_config_t *)driver->comms_config;
@@ -127,6 +161,9 @@ const painter_comms_with_command_vtable_t spi_comms_with_dc_vtable = {
             .comms_start = qp_comms_spi_start,
             .comms_send  = qp_comms_spi_dc_reset_send_data,
             .comms_stop  = qp_comms_spi_stop,
+#        ifdef SPI_TRANSMIT_ASYNC_SUPPORTED
+            .comms_send_async = qp_comms_spi_dc_reset_send_data_async,
+#        endif // SPI_TRANSMIT_ASYNC_SUPPORTED
         },
     .send_command          = qp_comms_spi_dc_reset_send_command,
     .bulk_command_sequence = qp_comms_spi_dc_reset_bulk_command_sequence,
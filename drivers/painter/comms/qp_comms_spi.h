@@ -8,6 +8,7 @@
 #    include <stdint.h>
 
 #    include "gpio.h"
+#    include "spi_master.h"
 #    include "qp_internal.h"
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -25,6 +26,10 @@ bool     qp_comms_spi_start(painter_device_t device);
 uint32_t qp_comms_spi_send_data(painter_device_t device, const void* data, uint32_t byte_count);
 void     qp_comms_spi_stop(painter_device_t device);
 
+#    ifdef SPI_TRANSMIT_ASYNC_SUPPORTED
+bool qp_comms_spi_send_data_async(painter_device_t device, const void* data, uint32_t byte_count, painter_async_complete_func callback, void* cb_arg);
+#    endif // SPI_TRANSMIT_ASYNC_SUPPORTED
+
 extern const painter_comms_vtable_t spi_comms_vtable;
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -42,6 +47,10 @@ void     qp_comms_spi_dc_reset_send_command(painter_device_t device, uint8_t cmd
 uint32_t qp_comms_spi_dc_reset_send_data(painter_device_t device, const void* data, uint32_t byte_count);
 void     qp_comms_spi_dc_reset_bulk_command_sequence(painter_device_t device, const uint8_t* sequence, size_t sequence_len);
 
+#        ifdef SPI_TRANSMIT_ASYNC_SUPPORTED
+bool qp_comms_spi_dc_reset_send_data_async(painter_device_t device, const void* data, uint32_t byte_count, painter_async_complete_func callback, void* cb_arg);
+#        endif // SPI_TRANSMIT_ASYNC_SUPPORTED
+
 extern const painter_comms_with_command_vtable_t spi_comms_with_dc_vtable;
 
 #    endif // QUANTUM_PAINTER_SPI_DC_RESET_ENABLE
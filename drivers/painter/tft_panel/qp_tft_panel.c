@@ -85,6 +85,11 @@ bool qp_tft_panel_pixdata(painter_device_t device, const void *pixel_data, uint3
     return true;
 }
 
+bool qp_tft_panel_pixdata_async(painter_device_t device, const void *pixel_data, uint32_t native_pixel_count, painter_async_complete_func callback, void *cb_arg) {
+    painter_driver_t *driver = (painter_driver_t *)device;
+    return qp_comms_send_async(device, pixel_data, native_pixel_count * driver->native_bits_per_pixel / 8, callback, cb_arg);
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Convert supplied palette entries into their native equivalents
 
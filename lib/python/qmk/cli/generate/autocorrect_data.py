@@ -24,6 +24,8 @@ Example:
   lenght        -> length
   ouput         -> output
   widht         -> width
+The trie is stored in reverse, branch nodes keep their child keys sorted with a
+table of links behind them so the firmware can binary search them.
 For full documentation, see QMK Docs
 """
 
@@ -80,6 +82,8 @@ def parse_file(file_name: str) -> List[Tuple[str, str]]:
 
     autocorrections = []
     typos = set()
+    # Every substring of the typos seen so far, mapped to the typo it came from
+    substrings = {}
     for line_number, typo, correction in parse_file_lines(file_name):
         if typo in typos:
             cli.log.warning('{fg_red}Error:%d:{fg_reset} Ignoring duplicate typo: "{fg_cyan}%s{fg_reset}"', line_number, typo)
@@ -89,10 +93,14 @@ def parse_file(file_name: str) -> List[Tuple[str, str]]:
         if not (all([c in TYPO_CHARS for c in typo])):
             cli.log.error('{fg_red}Error:%d:{fg_reset} Typo "{fg_cyan}%s{fg_reset}" has characters other than a-z, \' and :.', line_number, typo)
             sys.exit(1)
-        for other_typo in typos:
-            if typo in other_typo or other_typo in typo:
-                cli.log.error('{fg_red}Error:%d:{fg_reset} Typos may not be substrings of one another, otherwise the longer typo would never trigger: "{fg_cyan}%s{fg_reset}" vs. "{fg_cyan}%s{fg_reset}".', line_number, typo, other_typo)
-                sys.exit(1)
+        # Look substrings up in sets rather than comparing against every other typo, large dictionaries would take ages otherwise.
+        typo_substrings = set(typo[i:j] for i in range(len(typo)) for j in range(i + 1, len(typo) + 1))
+        other_typo = substrings.get(typo) or next((s for s in typo_substrings if s in typos), None)
+        if other_typo:
+            cli.log.error('{fg_red}Error:%d:{fg_reset} Typos may not be substrings of one another, otherwise the longer typo would never trigger: "{fg_cyan}%s{fg_reset}" vs. "{fg_cyan}%s{fg_reset}".', line_number, typo, other_typo)
+            sys.exit(1)
+        for substring in typo_substrings:
+            substrings.setdefault(substring, typo)
         if len(typo) < 5:
             cli.log.warning('{fg_yellow}Warning:%d:{fg_reset} It is suggested that typos are at least 5 characters long to avoid false triggers: "{fg_cyan}%s{fg_reset}"', line_number, typo)
         if len(typo) > 127:
@@ -165,13 +173,13 @@ def check_typo_against_dictionary(typo: str, line_number: int, correct_words) ->
                 cli.log.warning('{fg_yellow}Warning:%d:{fg_reset} Typo "{fg_cyan}%s{fg_reset}" would falsely trigger on correctly spelled word "{fg_cyan}%s{fg_reset}".', line_number, typo, word)
 
 
-def serialize_trie(autocorrections: List[Tuple[str, str]], trie: Dict[str, Any]) -> List[int]:
+def serialize_trie(autocorrections: List[Tuple[str, str]], trie: Dict[str, Any]) -> Tuple[List[int], int]:
     """Serializes trie and correction data in a form readable by the C code.
   Args:
     autocorrections: List of (typo, correction) tuples.
     trie: Dict of dicts.
   Returns:
-    List of ints in the range 0-255.
+    List of ints in the range 0-255, and the number of bytes per node link.
   """
     table = []
 
@@ -205,40 +213,42 @@ def serialize_trie(autocorrections: List[Tuple[str, str]], trie: Dict[str, Any])
             table.append(entry)
             entry['links'] = [traverse(trie_node)]
         else:  # Handle trie node with multiple children.
-            entry = {'chars': ''.join(sorted(trie_node.keys())), 'byte_offset': 0}
+            entry = {'chars': ''.join(sorted(trie_node.keys(), key=TYPO_CHARS.get)), 'byte_offset': 0}
             table.append(entry)
             entry['links'] = [traverse(trie_node[c]) for c in entry['chars']]
         return entry
 
     traverse(trie)
 
-    def serialize(e: Dict[str, Any]) -> List[int]:
+    def serialize(e: Dict[str, Any], link_size: int) -> List[int]:
         if not e['links']:  # Handle a leaf table entry.
             return e['data']
         elif len(e['links']) == 1:  # Handle a chain table entry.
             return [TYPO_CHARS[c] for c in e['chars']] + [0]  # + encode_link(e['links'][0]))
-        else:  # Handle a branch table entry.
-            data = []
-            for c, link in zip(e['chars'], e['links']):
-                data += [TYPO_CHARS[c] | (0 if data else 64)] + encode_link(link)
-            return data + [0]
-
-    byte_offset = 0
-    for e in table:  # To encode links, first compute byte offset of each entry.
-        e['byte_offset'] = byte_offset
-        byte_offset += len(serialize(e))
-        assert 0 <= byte_offset <= 0xffff
-
-    return [b for e in table for b in serialize(e)]  # Serialize final table.
-
-
-def encode_link(link: Dict[str, Any]) -> List[int]:
-    """Encodes a node link as two bytes."""
-    byte_offset = link['byte_offset']
-    if not (0 <= byte_offset <= 0xffff):
-        cli.log.error('{fg_red}Error:{fg_reset} The autocorrection table is too large, a node link exceeds 64KB limit. Try reducing the autocorrection dict to fewer entries.')
+        else:  # Handle a branch table entry, the child count then sorted keys then links.
+            data = [64 + len(e['chars'])] + [TYPO_CHARS[c] for c in e['chars']]
+            for link in e['links']:
+                data += encode_link(link, link_size)
+            return data
+
+    # Links are two bytes unless the table outgrows 64KB, in which case it needs three.
+    for link_size in (2, 3):
+        byte_offset = 0
+        for e in table:  # To encode links, first compute byte offset of each entry.
+            e['byte_offset'] = byte_offset
+            byte_offset += len(serialize(e, link_size))
+        if byte_offset <= 1 << (8 * link_size):
+            break
+    else:
+        cli.log.error('{fg_red}Error:{fg_reset} The autocorrection table is too large, a node link exceeds the 16MB limit. Try reducing the autocorrection dict to fewer entries.')
         sys.exit(1)
-    return [byte_offset & 255, byte_offset >> 8]
+
+    return [b for e in table for b in serialize(e, link_size)], link_size  # Serialize final table.
+
+
+def encode_link(link: Dict[str, Any], link_size: int) -> List[int]:
+    """Encodes a node link as `link_size` little endian bytes."""
+    return [(link['byte_offset'] >> (8 * i)) & 255 for i in range(link_size)]
 
 
 def typo_len(e: Tuple[str, str]) -> int:
@@ -258,7 +268,7 @@ def to_hex(b: int) -> str:
 def generate_autocorrect_data(cli):
     autocorrections = parse_file(cli.args.filename)
     trie = make_trie(autocorrections)
-    data = serialize_trie(autocorrections, trie)
+    data, link_size = serialize_trie(autocorrections, trie)
 
     current_keyboard = cli.args.keyboard or cli.config.user.keyboard or cli.config.generate_autocorrect_data.keyboard
     current_keymap = cli.args.keymap or cli.config.user.keymap or cli.config.generate_autocorrect_data.keymap
@@ -282,6 +292,8 @@ def generate_autocorrect_data(cli):
     autocorrect_data_h_lines.append(f'#define AUTOCORRECT_MIN_LENGTH {len(min_typo)} // "{min_typo}"')
     autocorrect_data_h_lines.append(f'#define AUTOCORRECT_MAX_LENGTH {len(max_typo)} // "{max_typo}"')
     autocorrect_data_h_lines.append(f'#define DICTIONARY_SIZE {len(data)}')
+    autocorrect_data_h_lines.append('#define AUTOCORRECT_DATA_VERSION 2')
+    autocorrect_data_h_lines.append(f'#define AUTOCORRECT_LINK_SIZE {link_size}')
     autocorrect_data_h_lines.append('')
     autocorrect_data_h_lines.append('static const uint8_t autocorrect_data[DICTIONARY_SIZE] PROGMEM = {')
     autocorrect_data_h_lines.append(textwrap.fill('    %s' % (', '.join(map(to_hex, data))), width=100, subsequent_indent='    '))
@@ -85,11 +85,38 @@ static const dacsample_t dac_buffer_trapezoid[AUDIO_DAC_BUFFER_SIZE] = {0x0,   0
 
 static dacsample_t dac_buffer_empty[AUDIO_DAC_BUFFER_SIZE] = {AUDIO_DAC_OFF_VALUE};
 
+#if defined(AUDIO_DAC_SAMPLE_WAVEFORM_SINE)
+#    define dac_wavetable dac_buffer_sine
+#elif defined(AUDIO_DAC_SAMPLE_WAVEFORM_TRIANGLE)
+#    define dac_wavetable dac_buffer_triangle
+#elif defined(AUDIO_DAC_SAMPLE_WAVEFORM_TRAPEZOID)
+#    define dac_wavetable dac_buffer_trapezoid
+#elif defined(AUDIO_DAC_SAMPLE_WAVEFORM_SQUARE)
+#    define dac_wavetable dac_buffer_square
+#endif
+
+/* the position in the wavetable is kept as a 32bit phase accumulator for each
+ * tone, with the top 8 bits indexing into the AUDIO_DAC_BUFFER_SIZE samples;
+ * wrapping around the end of the table is then just the integer overflow
+ *
+ * the 2/3 are necessary to get the correct frequencies on the DAC output (as
+ * measured with an oscilloscope), since the gpt timer runs with
+ * 3*AUDIO_DAC_SAMPLE_RATE; and the DAC callback is called twice per conversion.
+ */
+_Static_assert(AUDIO_DAC_BUFFER_SIZE == 256, "AUDIO_DAC: the phase accumulators expect 256 samples per wavetable");
+#define DAC_PHASE_SHIFT 24
+#define DAC_PHASE_PER_HZ (4294967296.0f * 2 / 3 / AUDIO_DAC_SAMPLE_RATE)
+
 /* keep track of the sample position for for each frequency */
-static float dac_if[AUDIO_MAX_SIMULTANEOUS_TONES] = {0.0};
+static uint32_t dac_phase[AUDIO_MAX_SIMULTANEOUS_TONES] = {0};
 
-static float   active_tones_snapshot[AUDIO_MAX_SIMULTANEOUS_TONES] = {0, 0};
-static uint8_t active_tones_snapshot_length                        = 0;
+/* phase increment per sample for each of the active tones, converted from
+ * their frequency whenever the snapshot is updated, so the per sample work
+ * in the DMA callback is integer only */
+static uint32_t active_tones_snapshot[AUDIO_MAX_SIMULTANEOUS_TONES] = {0};
+static uint8_t  active_tones_snapshot_length                        = 0;
+// 65536 / active_tones_snapshot_length, to mix the tones without a division per sample
+static uint32_t active_tones_mix_scale = 0;
 
 typedef enum {
     OUTPUT_SHOULD_START,
@@ -119,50 +146,35 @@ __attribute__((weak)) uint16_t dac_value_generate(void) {
 
     /* doing additive wave synthesis over all currently playing tones = adding up
      * sine-wave-samples for each frequency, scaled by the number of active tones
+     *
+     * Note: a user implementation does not have to rely on the active_tones_snapshot, but
+     * could directly query the active frequencies through audio_get_processed_frequency
      */
-    uint16_t value     = 0;
-    float    frequency = 0.0f;
+    uint32_t value = 0;
 
     for (uint8_t i = 0; i < active_tones_snapshot_length; i++) {
-        /* Note: a user implementation does not have to rely on the active_tones_snapshot, but
-         * could directly query the active frequencies through audio_get_processed_frequency */
-        frequency = active_tones_snapshot[i];
-
-        dac_if[i] = dac_if[i] + ((frequency * AUDIO_DAC_BUFFER_SIZE) / AUDIO_DAC_SAMPLE_RATE) * 2 / 3;
-        /*Note: the 2/3 are necessary to get the correct frequencies on the
-         *      DAC output (as measured with an oscilloscope), since the gpt
-         *      timer runs with 3*AUDIO_DAC_SAMPLE_RATE; and the DAC callback
-         *      is called twice per conversion.*/
-
-        dac_if[i] = fmod(dac_if[i], AUDIO_DAC_BUFFER_SIZE);
+        dac_phase[i] += active_tones_snapshot[i];
+        value += dac_wavetable[dac_phase[i] >> DAC_PHASE_SHIFT];
+    }
 
-        // Wavetable generation/lookup
-        uint16_t dac_i = (uint16_t)dac_if[i];
+    return (value * active_tones_mix_scale) >> 16;
+}
 
-#if defined(AUDIO_DAC_SAMPLE_WAVEFORM_SINE)
-        value += dac_buffer_sine[dac_i] / active_tones_snapshot_length;
-#elif defined(AUDIO_DAC_SAMPLE_WAVEFORM_TRIANGLE)
-        value += dac_buffer_triangle[dac_i] / active_tones_snapshot_length;
-#elif defined(AUDIO_DAC_SAMPLE_WAVEFORM_TRAPEZOID)
-        value += dac_buffer_trapezoid[dac_i] / active_tones_snapshot_length;
-#elif defined(AUDIO_DAC_SAMPLE_WAVEFORM_SQUARE)
-        value += dac_buffer_square[dac_i] / active_tones_snapshot_length;
-#endif
-        /*
-        // SINE
-        value += dac_buffer_sine[dac_i] / active_tones_snapshot_length / 3;
-        // TRIANGLE
-        value += dac_buffer_triangle[dac_i] / active_tones_snapshot_length / 3;
-        // SQUARE
-        value += dac_buffer_square[dac_i] / active_tones_snapshot_length / 3;
-        //NOTE: combination of these three wave-forms is more exemplary - and doesn't sound particularly good :-P
-        */
-
-        // STAIRS (mostly usefully as test-pattern)
-        // value_avg = dac_buffer_staircase[dac_i] / active_tones_snapshot_length;
+static void dac_update_snapshot(void) {
+    uint8_t active_tones         = MIN(AUDIO_MAX_SIMULTANEOUS_TONES, audio_get_number_of_active_tones());
+    active_tones_snapshot_length = 0;
+    // update the snapshot - once, and only on occasion that something changed;
+    // -> saves cpu cycles (?)
+    for (uint8_t i = 0; i < active_tones; i++) {
+        float freq = audio_get_processed_frequency(i);
+        if (freq > 0) { // disregard 'rest' notes, with valid frequency 0.0f; which would only lower the resulting waveform volume during the additive synthesis step
+            active_tones_snapshot[active_tones_snapshot_length++] = (uint32_t)(freq * DAC_PHASE_PER_HZ);
+        }
     }
 
-    return value;
+    if (active_tones_snapshot_length > 0) {
+        active_tones_mix_scale = 65536U / active_tones_snapshot_length;
+    }
 }
 
 /**
@@ -218,16 +230,7 @@ static void dac_end(DACDriver *dacp) {
         }
 
         if ((OUTPUT_SHOULD_START == state) || (OUTPUT_REACHED_ZERO_BEFORE_OFF == state) || (OUTPUT_REACHED_ZERO_BEFORE_TONE_CHANGE == state)) {
-            uint8_t active_tones         = MIN(AUDIO_MAX_SIMULTANEOUS_TONES, audio_get_number_of_active_tones());
-            active_tones_snapshot_length = 0;
-            // update the snapshot - once, and only on occasion that something changed;
-            // -> saves cpu cycles (?)
-            for (uint8_t i = 0; i < active_tones; i++) {
-                float freq = audio_get_processed_frequency(i);
-                if (freq > 0) { // disregard 'rest' notes, with valid frequency 0.0f; which would only lower the resulting waveform volume during the additive synthesis step
-                    active_tones_snapshot[active_tones_snapshot_length++] = freq;
-                }
-            }
+            dac_update_snapshot();
 
             if ((0 == active_tones_snapshot_length) && (OUTPUT_REACHED_ZERO_BEFORE_OFF == state)) {
                 state = OUTPUT_OFF;
@@ -333,8 +336,8 @@ void audio_driver_start(void) {
     gptStartContinuous(&GPTD6, 2U);
 
     for (uint8_t i = 0; i < AUDIO_MAX_SIMULTANEOUS_TONES; i++) {
-        dac_if[i]                = 0.0f;
-        active_tones_snapshot[i] = 0.0f;
+        dac_phase[i]             = 0;
+        active_tones_snapshot[i] = 0;
     }
     active_tones_snapshot_length = 0;
     state                        = OUTPUT_SHOULD_START;
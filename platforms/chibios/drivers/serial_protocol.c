@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include <ch.h>
+#include <string.h>
 
 #include "quantum.h"
 #include "serial.h"
@@ -9,6 +10,23 @@
 #include "printf.h"
 #include "synchronization_util.h"
 
+#ifdef SPLIT_TRANSPORT_THREAD
+#    include "crc.h"
+
+#    ifndef SPLIT_TRANSPORT_THREAD_TIMEOUT
+#        define SPLIT_TRANSPORT_THREAD_TIMEOUT 100
+#    endif
+
+/* Set in the first byte of a batch, the remaining bits carry the number of
+ * transactions that follow. */
+#    define SPLIT_BATCH_FLAG 0x80
+
+_Static_assert(NUM_TOTAL_TRANSACTIONS < SPLIT_BATCH_FLAG, "Too many split transactions to fit into a batch");
+
+static inline bool initiate_batch(const uint8_t* transaction_ids, uint8_t count);
+static inline bool react_to_batch(uint8_t count);
+#endif // SPLIT_TRANSPORT_THREAD
+
 static inline bool initiate_transaction(uint8_t transaction_id);
 static inline bool react_to_transaction(void);
 
@@ -40,13 +58,102 @@ void soft_serial_target_init(void) {
     chThdCreateStatic(waSlaveThread, sizeof(waSlaveThread), HIGHPRIO, SlaveThread, NULL);
 }
 
+#ifdef SPLIT_TRANSPORT_THREAD
+
+/* Transaction state shared between the main loop and the master thread,
+ * guarded by the split shared memory lock. */
+#    define SPLIT_TRANSACTION_QUEUED (1 << 0)    /* Requested since the last batch was started. */
+#    define SPLIT_TRANSACTION_IN_FLIGHT (1 << 1) /* Part of the batch currently on the wire. */
+#    define SPLIT_TRANSACTION_FAILED (1 << 2)    /* The last batch carrying it failed. */
+
+static uint8_t split_transaction_state[NUM_TOTAL_TRANSACTIONS];
+
+/* The master thread works on its own copy of the shared memory, so the main
+ * loop only ever sees buffers from a completed batch. */
+static split_shared_memory_t split_thread_memory;
+#    define split_thread_buffer(offset) (((uint8_t*)&split_thread_memory) + (offset))
+
+static thread_t* split_master_thread;
+static BSEMAPHORE_DECL(split_batch_done, true);
+
+/**
+ * @brief This thread runs on the master and sends every transaction queued by
+ * the main loop to the slave in one batch.
+ */
+static THD_WORKING_AREA(waMasterThread, 1024);
+static THD_FUNCTION(MasterThread, arg) {
+    (void)arg;
+    chRegSetThreadName("split_protocol_batch");
+
+    uint8_t transaction_ids[NUM_TOTAL_TRANSACTIONS];
+
+    while (true) {
+        /* Woken up by soft_serial_transaction(). */
+        chEvtWaitAny(ALL_EVENTS);
+
+        uint8_t count = 0;
+        {
+            split_shared_memory_lock_autounlock();
+            for (uint8_t id = 0; id < NUM_TOTAL_TRANSACTIONS; id++) {
+                if (split_transaction_state[id] & SPLIT_TRANSACTION_QUEUED) {
+                    split_transaction_desc_t* transaction = &split_transaction_table[id];
+                    memcpy(split_thread_buffer(transaction->initiator2target_offset), split_trans_initiator2target_buffer(transaction), transaction->initiator2target_buffer_size);
+                    split_transaction_state[id] = SPLIT_TRANSACTION_IN_FLIGHT;
+                    transaction_ids[count++]    = id;
+                }
+            }
+        }
+
+        if (count == 0) {
+            continue;
+        }
+
+        /* Clear the receive queue, to start with a clean slate.
+         * Parts of failed transactions or spurious bytes could still be in it. */
+        serial_transport_driver_clear();
+        bool okay = initiate_batch(transaction_ids, count);
+
+        {
+            split_shared_memory_lock_autounlock();
+            for (uint8_t i = 0; i < count; i++) {
+                uint8_t                   id          = transaction_ids[i];
+                split_transaction_desc_t* transaction = &split_transaction_table[id];
+                if (okay) {
+                    memcpy(split_trans_target2initiator_buffer(transaction), split_thread_buffer(transaction->target2initiator_offset), transaction->target2initiator_buffer_size);
+                }
+                /* Keep the queued bit, if the main loop asked for it again in the meantime. */
+                split_transaction_state[id] &= ~(SPLIT_TRANSACTION_IN_FLIGHT | SPLIT_TRANSACTION_FAILED);
+                if (!okay) {
+                    split_transaction_state[id] |= SPLIT_TRANSACTION_FAILED;
+                }
+            }
+        }
+
+        chBSemSignal(&split_batch_done);
+    }
+}
+
 /**
  * @brief Master specific initializations.
  */
 void soft_serial_initiator_init(void) {
     serial_transport_driver_master_init();
+
+    /* Start transport thread. */
+    split_master_thread = chThdCreateStatic(waMasterThread, sizeof(waMasterThread), HIGHPRIO, MasterThread, NULL);
 }
 
+#else // SPLIT_TRANSPORT_THREAD
+
+/**
+ * @brief Master specific initializations.
+ */
+void soft_serial_initiator_init(void) {
+    serial_transport_driver_master_init();
+}
+
+#endif // SPLIT_TRANSPORT_THREAD
+
 /**
  * @brief React to transactions started by the master.
  */
@@ -57,6 +164,12 @@ static inline bool react_to_transaction(void) {
         return false;
     }
 
+#ifdef SPLIT_TRANSPORT_THREAD
+    if (transaction_id & SPLIT_BATCH_FLAG) {
+        return react_to_batch(transaction_id & ~SPLIT_BATCH_FLAG);
+    }
+#endif // SPLIT_TRANSPORT_THREAD
+
     /* Sanity check that we are actually responding to a valid transaction. */
     if (unlikely(transaction_id >= NUM_TOTAL_TRANSACTIONS)) {
         return false;
@@ -95,6 +208,175 @@ static inline bool react_to_transaction(void) {
     return true;
 }
 
+#ifdef SPLIT_TRANSPORT_THREAD
+
+/**
+ * @brief React to a batch of transactions started by the master thread. The
+ * transactions are handled in the order they were sent, and answered together
+ * once all of them have been received.
+ */
+static inline bool react_to_batch(uint8_t count) {
+    uint8_t transaction_ids[NUM_TOTAL_TRANSACTIONS];
+
+    if (unlikely(count == 0 || count > NUM_TOTAL_TRANSACTIONS)) {
+        return false;
+    }
+
+    if (unlikely(!serial_transport_receive(transaction_ids, count))) {
+        return false;
+    }
+
+    for (uint8_t i = 0; i < count; i++) {
+        if (unlikely(transaction_ids[i] >= NUM_TOTAL_TRANSACTIONS)) {
+            return false;
+        }
+    }
+
+    split_shared_memory_lock_autounlock();
+
+    for (uint8_t i = 0; i < count; i++) {
+        split_transaction_desc_t* transaction = &split_transaction_table[transaction_ids[i]];
+
+        /* Receive transaction buffer from the master. If this transaction requires it.*/
+        if (transaction->initiator2target_buffer_size) {
+            if (unlikely(!serial_transport_receive(split_trans_initiator2target_buffer(transaction), transaction->initiator2target_buffer_size))) {
+                return false;
+            }
+        }
+
+        /* Allow any slave processing to occur. */
+        if (transaction->slave_callback) {
+            transaction->slave_callback(transaction->initiator2target_buffer_size, split_trans_initiator2target_buffer(transaction), transaction->initiator2target_buffer_size, split_trans_target2initiator_buffer(transaction));
+        }
+    }
+
+    /* A single handshake for the whole batch, which proves that the slave
+     * received the same list of transactions the master sent. */
+    uint8_t handshake = crc8(transaction_ids, count);
+    if (unlikely(!serial_transport_send(&handshake, sizeof(handshake)))) {
+        return false;
+    }
+
+    /* Send transaction buffers to the master. If the transactions require it. */
+    for (uint8_t i = 0; i < count; i++) {
+        split_transaction_desc_t* transaction = &split_transaction_table[transaction_ids[i]];
+        if (transaction->target2initiator_buffer_size) {
+            if (unlikely(!serial_transport_send(split_trans_target2initiator_buffer(transaction), transaction->target2initiator_buffer_size))) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Transactions whose result depends on the request that was just made
+ * have to wait for their batch, everything else is answered with the result
+ * of the last completed batch.
+ */
+static inline bool is_synchronous_transaction(uint8_t transaction_id) {
+#    if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
+    return transaction_id >= PUT_RPC_INFO;
+#    else
+    return false;
+#    endif
+}
+
+/**
+ * @brief Wait until the master thread completed a batch carrying the given
+ * transaction.
+ */
+static bool wait_for_transaction(uint8_t transaction_id) {
+    const systime_t start = chVTGetSystemTimeX();
+
+    do {
+        {
+            split_shared_memory_lock_autounlock();
+            if (!(split_transaction_state[transaction_id] & (SPLIT_TRANSACTION_QUEUED | SPLIT_TRANSACTION_IN_FLIGHT))) {
+                return !(split_transaction_state[transaction_id] & SPLIT_TRANSACTION_FAILED);
+            }
+        }
+        chBSemWaitTimeout(&split_batch_done, TIME_MS2I(SPLIT_TRANSPORT_THREAD_TIMEOUT));
+    } while (chVTTimeElapsedSinceX(start) < TIME_MS2I(SPLIT_TRANSPORT_THREAD_TIMEOUT));
+
+    serial_dprintf("SPLIT: waiting for batch timed out\n");
+    return false;
+}
+
+/**
+ * @brief Queue a transaction for the master thread.
+ *
+ * @param index Transaction Table index of the transaction to queue.
+ * @return bool Indicates success of the last batch that carried this
+ * transaction, or of the batch carrying this request for RPCs.
+ */
+bool soft_serial_transaction(int index) {
+    /* Sanity check that we are actually starting a valid transaction. */
+    if (unlikely(index < 0 || index >= NUM_TOTAL_TRANSACTIONS)) {
+        serial_dprintf("SPLIT: illegal transaction id\n");
+        return false;
+    }
+
+    bool okay;
+    {
+        split_shared_memory_lock_autounlock();
+        okay = !(split_transaction_state[index] & SPLIT_TRANSACTION_FAILED);
+        split_transaction_state[index] |= SPLIT_TRANSACTION_QUEUED;
+    }
+    chEvtSignal(split_master_thread, EVENT_MASK(0));
+
+    if (is_synchronous_transaction(index)) {
+        return wait_for_transaction(index);
+    }
+    return okay;
+}
+
+/**
+ * @brief Send a batch of transactions to the slave half, with a single
+ * handshake at the end rather than one per transaction.
+ */
+static inline bool initiate_batch(const uint8_t* transaction_ids, uint8_t count) {
+    uint8_t header = SPLIT_BATCH_FLAG | count;
+
+    if (unlikely(!serial_transport_send(&header, sizeof(header)) || !serial_transport_send(transaction_ids, count))) {
+        serial_dprintf("SPLIT: sending batch header failed\n");
+        return false;
+    }
+
+    /* Send transaction buffers to the slave. If the transactions require it. */
+    for (uint8_t i = 0; i < count; i++) {
+        split_transaction_desc_t* transaction = &split_transaction_table[transaction_ids[i]];
+        if (transaction->initiator2target_buffer_size) {
+            if (unlikely(!serial_transport_send(split_thread_buffer(transaction->initiator2target_offset), transaction->initiator2target_buffer_size))) {
+                serial_dprintf("SPLIT: sending buffer failed\n");
+                return false;
+            }
+        }
+    }
+
+    uint8_t handshake = 0;
+    if (unlikely(!serial_transport_receive(&handshake, sizeof(handshake)) || handshake != crc8(transaction_ids, count))) {
+        serial_dprintf("SPLIT: receiving handshake failed\n");
+        return false;
+    }
+
+    /* Receive transaction buffers from the slave. If the transactions require it. */
+    for (uint8_t i = 0; i < count; i++) {
+        split_transaction_desc_t* transaction = &split_transaction_table[transaction_ids[i]];
+        if (transaction->target2initiator_buffer_size) {
+            if (unlikely(!serial_transport_receive(split_thread_buffer(transaction->target2initiator_offset), transaction->target2initiator_buffer_size))) {
+                serial_dprintf("SPLIT: receiving buffer failed\n");
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+#else // SPLIT_TRANSPORT_THREAD
+
 /**
  * @brief Start transaction from the master half to the slave half.
  *
@@ -109,6 +391,8 @@ bool soft_serial_transaction(int index) {
     return initiate_transaction((uint8_t)index);
 }
 
+#endif // SPLIT_TRANSPORT_THREAD
+
 /**
  * @brief Initiate transaction to slave half.
  */
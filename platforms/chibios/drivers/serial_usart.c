@@ -6,14 +6,24 @@
 #include "serial_protocol.h"
 #include "synchronization_util.h"
 
+#if HAL_USE_UART && !HAL_USE_SERIAL && !HAL_USE_SIO && defined(SERIAL_USART_UART_DMA)
+#    include <string.h>
+#    include "crc.h"
+
+static void usart_rxchar_cb(UARTDriver* uartp, uint16_t c);
+#endif
+
 #if defined(SERIAL_USART_CONFIG)
 static QMKSerialConfig serial_config = SERIAL_USART_CONFIG;
 #elif defined(MCU_STM32) /* STM32 MCUs */
 static QMKSerialConfig serial_config = {
 #    if HAL_USE_SERIAL
     .speed = (SERIAL_USART_SPEED),
-#    else
+#    elif HAL_USE_SIO
     .baud = (SERIAL_USART_SPEED),
+#    elif HAL_USE_UART && defined(SERIAL_USART_UART_DMA)
+    .rxchar_cb = usart_rxchar_cb,
+    .speed     = (SERIAL_USART_SPEED),
 #    endif
     .cr1   = (SERIAL_USART_CR1),
     .cr2   = (SERIAL_USART_CR2),
@@ -90,12 +100,135 @@ inline void serial_transport_driver_clear(void) {
     osalSysUnlock();
 }
 
+#elif HAL_USE_UART && defined(SERIAL_USART_UART_DMA)
+
+/* Every send is wrapped into a frame of a length byte, the payload and a CRC8
+ * of the payload. As both halves always know how much data to expect next,
+ * the length also tells the receiver where a frame ends. Single bytes, i.e.
+ * transaction ids and handshakes, go out as they are like on the SERIAL and
+ * SIO drivers, as a frame would triple their size. */
+#    define SERIAL_USART_FRAME_OVERHEAD 2
+#    define SERIAL_USART_FRAMED(size) ((size) > 1)
+#    define SERIAL_USART_FRAME_SIZE(size) (SERIAL_USART_FRAMED(size) ? (size) + SERIAL_USART_FRAME_OVERHEAD : (size))
+
+#    if !defined(SERIAL_USART_EARLY_RX_BUFFER_SIZE)
+#        define SERIAL_USART_EARLY_RX_BUFFER_SIZE 16
+#    endif
+
+static uint8_t tx_frame[SERIAL_USART_FRAME_SIZE(UINT8_MAX)];
+static uint8_t rx_frame[SERIAL_USART_FRAME_SIZE(UINT8_MAX)];
+
+/* Bytes that arrived while no DMA receive was running, e.g. the start of a
+ * reply that came in before we were done sending. */
+static uint8_t          early_rx_buffer[SERIAL_USART_EARLY_RX_BUFFER_SIZE];
+static volatile uint8_t early_rx_count    = 0;
+static volatile bool    early_rx_overflow = false;
+
+/**
+ * @brief UART Driver startup routine.
+ */
+static inline void usart_driver_start(void) {
+    uartStart(serial_driver, &serial_config);
+}
+
+/**
+ * @brief Called from the ISR for every byte received while no DMA receive is
+ * running.
+ */
+static void usart_rxchar_cb(UARTDriver* uartp, uint16_t c) {
+    (void)uartp;
+    if (likely(early_rx_count < sizeof(early_rx_buffer))) {
+        early_rx_buffer[early_rx_count++] = (uint8_t)c;
+    } else {
+        early_rx_overflow = true;
+    }
+}
+
+inline void serial_transport_driver_clear(void) {
+    osalSysLock();
+    uartStopReceiveI(serial_driver);
+    early_rx_count    = 0;
+    early_rx_overflow = false;
+    osalSysUnlock();
+}
+
+inline bool serial_transport_send(const uint8_t* source, const size_t size) {
+    if (unlikely(size > UINT8_MAX)) {
+        return false;
+    }
+
+    size_t frame_size = SERIAL_USART_FRAME_SIZE(size);
+    if (!SERIAL_USART_FRAMED(size)) {
+        return uartSendFullTimeout(serial_driver, &frame_size, source, TIME_MS2I(SERIAL_USART_TIMEOUT)) == MSG_OK;
+    }
+
+    tx_frame[0] = (uint8_t)size;
+    memcpy(&tx_frame[1], source, size);
+    tx_frame[size + 1] = crc8(source, size);
+
+    return uartSendFullTimeout(serial_driver, &frame_size, tx_frame, TIME_MS2I(SERIAL_USART_TIMEOUT)) == MSG_OK;
+}
+
+static bool usart_receive_frame(uint8_t* destination, const size_t size, sysinterval_t timeout) {
+    if (unlikely(size > UINT8_MAX)) {
+        return false;
+    }
+
+    const size_t frame_size = SERIAL_USART_FRAME_SIZE(size);
+    const size_t offset     = SERIAL_USART_FRAMED(size) ? 1 : 0;
+    msg_t        msg        = MSG_OK;
+
+    osalSysLock();
+    if (unlikely(early_rx_overflow)) {
+        osalSysUnlock();
+        return false;
+    }
+
+    /* Take what already arrived and keep anything beyond this frame for the
+     * next one, then let the DMA fetch the rest. Doing both while locked
+     * ensures no byte slips in between. */
+    size_t early = MIN(early_rx_count, frame_size);
+    memcpy(rx_frame, early_rx_buffer, early);
+    memmove(early_rx_buffer, &early_rx_buffer[early], early_rx_count - early);
+    early_rx_count -= early;
+
+    if (early < frame_size) {
+        uartStartReceiveI(serial_driver, frame_size - early, &rx_frame[early]);
+        msg = osalThreadSuspendTimeoutS(&serial_driver->threadrx, timeout);
+        if (unlikely(msg != MSG_OK)) {
+            uartStopReceiveI(serial_driver);
+        }
+    }
+    osalSysUnlock();
+
+    if (unlikely(msg != MSG_OK)) {
+        return false;
+    }
+
+    if (SERIAL_USART_FRAMED(size) && unlikely(rx_frame[0] != size || rx_frame[size + 1] != crc8(&rx_frame[1], size))) {
+        return false;
+    }
+
+    memcpy(destination, &rx_frame[offset], size);
+    return true;
+}
+
+inline bool serial_transport_receive(uint8_t* destination, const size_t size) {
+    return usart_receive_frame(destination, size, TIME_MS2I(SERIAL_USART_TIMEOUT));
+}
+
+inline bool serial_transport_receive_blocking(uint8_t* destination, const size_t size) {
+    return usart_receive_frame(destination, size, TIME_INFINITE);
+}
+
 #else
 
-#    error Either the SERIAL or SIO driver has to be activated to use the usart driver for split keyboards.
+#    error Either the SERIAL or SIO driver, or the UART driver together with SERIAL_USART_UART_DMA, has to be activated to use the usart driver for split keyboards.
 
 #endif
 
+#if HAL_USE_SERIAL || HAL_USE_SIO
+
 inline bool serial_transport_send(const uint8_t* source, const size_t size) {
     bool success = (size_t)chnWriteTimeout(serial_driver, source, size, TIME_MS2I(SERIAL_USART_TIMEOUT)) == size;
 
@@ -153,6 +286,8 @@ inline bool serial_transport_receive_blocking(uint8_t* destination, const size_t
     return success;
 }
 
+#endif // HAL_USE_SERIAL || HAL_USE_SIO
+
 #if !defined(SERIAL_USART_FULL_DUPLEX)
 
 /**
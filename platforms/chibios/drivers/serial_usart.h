@@ -63,6 +63,27 @@ typedef SIOConfig QMKSerialConfig;
 #        define SERIAL_USART_DRIVER SIOD1
 #    endif
 
+#elif HAL_USE_UART && defined(SERIAL_USART_UART_DMA)
+
+#    if !defined(SERIAL_USART_FULL_DUPLEX)
+#        error The UART driver only supports Full-duplex operation.
+#    endif
+
+#    if !UART_USE_WAIT
+#        error The UART driver requires UART_USE_WAIT to be enabled in halconf.h.
+#    endif
+
+typedef UARTDriver QMKSerialDriver;
+typedef UARTConfig QMKSerialConfig;
+
+#    if !defined(SERIAL_USART_DRIVER)
+#        define SERIAL_USART_DRIVER UARTD1
+#    endif
+
+#elif HAL_USE_UART
+
+#    error The UART driver is experimental and has to be enabled with SERIAL_USART_UART_DMA in config.h.
+
 #endif
 
 #if !defined(USE_GPIOV1)
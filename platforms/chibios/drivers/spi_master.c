@@ -26,6 +26,20 @@ static SPIConfig spiConfig = {NULL, 0, 0, 0};
 static SPIConfig spiConfig = {false, NULL, 0, 0, 0, 0};
 #endif
 
+#ifdef SPI_TRANSMIT_ASYNC_SUPPORTED
+// Set while an asynchronous transmit is in flight, only that transfer completes through spiConfig.end_cb
+static volatile spi_async_callback_t async_callback = NULL;
+
+static void spi_transmit_async_complete(SPIDriver *spip) {
+    spi_async_callback_t callback = async_callback;
+    async_callback                = NULL;
+    spiConfig.end_cb              = NULL;
+    if (callback) {
+        callback();
+    }
+}
+#endif
+
 __attribute__((weak)) void spi_init(void) {
     static bool is_initialised = false;
     if (!is_initialised) {
@@ -250,6 +264,7 @@ bool spi_start(pin_t slavePin, bool lsbFirst, uint8_t mode, uint16_t divisor) {
     currentSlavePin  = slavePin;
     spiConfig.ssport = PAL_PORT(slavePin);
     spiConfig.sspad  = PAL_PAD(slavePin);
+    spiConfig.end_cb = NULL;
 
     setPinOutput(slavePin);
     spiStart(&SPI_DRIVER, &spiConfig);
@@ -282,8 +297,38 @@ spi_status_t spi_receive(uint8_t *data, uint16_t length) {
     return SPI_STATUS_SUCCESS;
 }
 
+#ifdef SPI_TRANSMIT_ASYNC_SUPPORTED
+spi_status_t spi_transmit_async(const uint8_t *data, uint16_t length, spi_async_callback_t callback) {
+    if (currentSlavePin == NO_PIN || length == 0 || callback == NULL) {
+        return SPI_STATUS_ERROR;
+    }
+
+    osalSysLock();
+    // Only one transfer at a time, the previous one has to complete or be stopped first
+    if (async_callback != NULL || SPI_DRIVER.state != SPI_READY) {
+        osalSysUnlock();
+        return SPI_STATUS_ERROR;
+    }
+    async_callback   = callback;
+    spiConfig.end_cb = spi_transmit_async_complete;
+    spiStartSendI(&SPI_DRIVER, length, data);
+    osalSysUnlock();
+    return SPI_STATUS_SUCCESS;
+}
+#endif
+
 void spi_stop(void) {
     if (currentSlavePin != NO_PIN) {
+#ifdef SPI_TRANSMIT_ASYNC_SUPPORTED
+        osalSysLock();
+        // Abort an asynchronous transmit that is still in flight, its callback is not invoked
+        if (async_callback != NULL) {
+            async_callback   = NULL;
+            spiConfig.end_cb = NULL;
+            spiAbortI(&SPI_DRIVER);
+        }
+        osalSysUnlock();
+#endif
         spiUnselect(&SPI_DRIVER);
         spiStop(&SPI_DRIVER);
         currentSlavePin = NO_PIN;
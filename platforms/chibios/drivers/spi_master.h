@@ -72,6 +72,12 @@ typedef int16_t spi_status_t;
 #define SPI_TIMEOUT_IMMEDIATE (0)
 #define SPI_TIMEOUT_INFINITE (0xFFFF)
 
+// spi_transmit_async() relies on spiAbortI() to stop a transfer that never completes
+#if SPI_SUPPORTS_CIRCULAR == TRUE
+#    define SPI_TRANSMIT_ASYNC_SUPPORTED
+typedef void (*spi_async_callback_t)(void);
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -87,6 +93,15 @@ spi_status_t spi_transmit(const uint8_t *data, uint16_t length);
 
 spi_status_t spi_receive(uint8_t *data, uint16_t length);
 
+#ifdef SPI_TRANSMIT_ASYNC_SUPPORTED
+/**
+ * Starts a DMA transmit and returns immediately. The callback is invoked from interrupt context once the transfer
+ * completes. Returns SPI_STATUS_ERROR if the bus is not started or is busy. spi_stop() aborts a transfer that has
+ * not completed yet, without invoking the callback.
+ */
+spi_status_t spi_transmit_async(const uint8_t *data, uint16_t length, spi_async_callback_t callback);
+#endif
+
 void spi_stop(void);
 #ifdef __cplusplus
 }
@@ -0,0 +1,299 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "effects_harness.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#    include <x86intrin.h>
+#endif
+
+#include "lib/lib8tion/lib8tion.h"
+
+void advance_time(uint32_t ms);
+void set_time(uint32_t t);
+
+////////////////////////////////////////////////////
+// Fake driver, one per matrix type
+
+static uint32_t frames_flushed;
+
+static void harness_init(void) {}
+
+static void harness_flush(void) {
+    frames_flushed++;
+}
+
+#if defined(RGB_MATRIX_ENABLE)
+#    include "rgb_matrix.h"
+
+#    define HARNESS_LED_COUNT RGB_MATRIX_LED_COUNT
+#    define HARNESS_FLUSH_LIMIT RGB_MATRIX_LED_FLUSH_LIMIT
+#    define HARNESS_EFFECT_MAX RGB_MATRIX_EFFECT_MAX
+#    ifdef RGB_MATRIX_FRAMEBUFFER_EFFECTS
+#        define HARNESS_FRAME_BUFFER g_rgb_frame_buffer
+#    endif
+
+#    define harness_matrix_init rgb_matrix_init
+#    define harness_matrix_task rgb_matrix_task
+#    define harness_matrix_mode rgb_matrix_mode_noeeprom
+#    define harness_matrix_press(row, col) process_rgb_matrix(row, col, true)
+#    define harness_matrix_set_on(index) rgb_matrix_set_color(index, 255, 255, 255)
+#    define harness_matrix_set_all_off() rgb_matrix_set_color_all(0, 0, 0)
+#    define harness_matrix_defaults eeconfig_update_rgb_matrix_default
+#    define harness_indicators_user rgb_matrix_indicators_advanced_user
+
+static RGB frame[RGB_MATRIX_LED_COUNT];
+
+static const char *const effect_names[] = {
+    "NONE",
+#    define RGB_MATRIX_EFFECT(name, ...) #name,
+#    include "rgb_matrix_effects.inc"
+#    undef RGB_MATRIX_EFFECT
+};
+
+static void harness_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
+    frame[index] = (RGB){.r = red, .g = green, .b = blue};
+}
+
+static void harness_set_color_all(uint8_t red, uint8_t green, uint8_t blue) {
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        harness_set_color(i, red, green, blue);
+    }
+}
+
+const rgb_matrix_driver_t rgb_matrix_driver = {
+    .init          = harness_init,
+    .set_color     = harness_set_color,
+    .set_color_all = harness_set_color_all,
+    .flush         = harness_flush,
+};
+
+#elif defined(LED_MATRIX_ENABLE)
+#    include "led_matrix.h"
+
+#    define HARNESS_LED_COUNT LED_MATRIX_LED_COUNT
+#    define HARNESS_FLUSH_LIMIT LED_MATRIX_LED_FLUSH_LIMIT
+#    define HARNESS_EFFECT_MAX LED_MATRIX_EFFECT_MAX
+#    ifdef LED_MATRIX_FRAMEBUFFER_EFFECTS
+#        define HARNESS_FRAME_BUFFER g_led_frame_buffer
+#    endif
+// LED Matrix leaves the flag unnamed, use the same bit as RGB Matrix
+#    define LED_FLAG_UNDERGLOW 0x02
+
+#    define harness_matrix_init led_matrix_init
+#    define harness_matrix_task led_matrix_task
+#    define harness_matrix_mode led_matrix_mode_noeeprom
+#    define harness_matrix_press(row, col) process_led_matrix(row, col, true)
+#    define harness_matrix_set_on(index) led_matrix_set_value(index, 255)
+#    define harness_matrix_set_all_off() led_matrix_set_value_all(0)
+#    define harness_matrix_defaults eeconfig_update_led_matrix_default
+#    define harness_indicators_user led_matrix_indicators_advanced_user
+
+static uint8_t frame[LED_MATRIX_LED_COUNT];
+
+static const char *const effect_names[] = {
+    "NONE",
+#    define LED_MATRIX_EFFECT(name, ...) #name,
+#    include "led_matrix_effects.inc"
+#    undef LED_MATRIX_EFFECT
+};
+
+static void harness_set_value(int index, uint8_t value) {
+    frame[index] = value;
+}
+
+static void harness_set_value_all(uint8_t value) {
+    for (uint8_t i = 0; i < LED_MATRIX_LED_COUNT; i++) {
+        harness_set_value(i, value);
+    }
+}
+
+const led_matrix_driver_t led_matrix_driver = {
+    .init          = harness_init,
+    .set_value     = harness_set_value,
+    .set_value_all = harness_set_value_all,
+    .flush         = harness_flush,
+};
+
+#else
+#    error "The effects harness needs either RGB_MATRIX_ENABLE or LED_MATRIX_ENABLE"
+#endif
+
+#define KEY_COUNT (MATRIX_ROWS * MATRIX_COLS)
+#define UNDERGLOW_COUNT (HARNESS_LED_COUNT - KEY_COUNT)
+
+_Static_assert(HARNESS_LED_COUNT < NO_LED, "LED indices are 8 bit, with NO_LED reserved");
+_Static_assert(HARNESS_LED_COUNT > KEY_COUNT, "Not enough LEDs for the generated layout");
+
+// Filled in by effects_harness_init()
+led_config_t g_led_config;
+
+static uint32_t frames_run;
+static uint32_t indicator_frames;
+
+////////////////////////////////////////////////////
+// Hooks
+
+// DIGITAL_RAIN draws from rand(), which is replaced so that its frames don't depend on the C library
+static uint32_t harness_rand_state = 1;
+
+void srand(unsigned int seed) {
+    harness_rand_state = seed;
+}
+
+int rand(void) {
+    // xorshift32, which never leaves a zero state
+    if (harness_rand_state == 0) {
+        harness_rand_state = 1;
+    }
+    harness_rand_state ^= harness_rand_state << 13;
+    harness_rand_state ^= harness_rand_state >> 17;
+    harness_rand_state ^= harness_rand_state << 5;
+    return harness_rand_state % ((uint32_t)RAND_MAX + 1);
+}
+
+// Written over the effect, like a lock indicator
+bool harness_indicators_user(uint8_t led_min, uint8_t led_max) {
+    if (frames_run < indicator_frames) {
+        for (uint8_t i = led_min; i < led_max; i++) {
+            if (i < KEY_COUNT && i % 3 == 0) {
+                harness_matrix_set_on(i);
+            }
+        }
+    }
+    return true;
+}
+
+////////////////////////////////////////////////////
+// Harness
+
+static uint64_t harness_cycles(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000 + now.tv_nsec;
+#endif
+}
+
+const char *effects_harness_cycle_unit(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    return "cycles";
+#else
+    return "ns";
+#endif
+}
+
+static void harness_layout(void) {
+    uint8_t led = 0;
+
+    // Keys on a regular grid across the whole 224x64 area, the outer columns and the bottom row as modifiers
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            bool modifier                    = col == 0 || col == MATRIX_COLS - 1 || row == MATRIX_ROWS - 1;
+            g_led_config.matrix_co[row][col] = led;
+            g_led_config.point[led]          = (led_point_t){.x = col * 224 / (MATRIX_COLS - 1), .y = row * 64 / (MATRIX_ROWS - 1)};
+            g_led_config.flags[led]          = modifier ? LED_FLAG_MODIFIER : LED_FLAG_KEYLIGHT;
+            led++;
+        }
+    }
+
+    // Underglow evenly spaced along the edges, clockwise from the top left corner
+    for (uint16_t i = 0; i < UNDERGLOW_COUNT; i++) {
+        uint16_t    position = i * 2 * (224 + 64) / UNDERGLOW_COUNT;
+        led_point_t point;
+        if (position < 224) {
+            point = (led_point_t){.x = position, .y = 0};
+        } else if (position < 224 + 64) {
+            point = (led_point_t){.x = 224, .y = position - 224};
+        } else if (position < 2 * 224 + 64) {
+            point = (led_point_t){.x = 2 * 224 + 64 - position, .y = 64};
+        } else {
+            point = (led_point_t){.x = 0, .y = 2 * (224 + 64) - position};
+        }
+        g_led_config.point[led] = point;
+        g_led_config.flags[led] = LED_FLAG_UNDERGLOW;
+        led++;
+    }
+}
+
+void effects_harness_init(void) {
+    harness_layout();
+    harness_matrix_init();
+}
+
+static uint32_t harness_hash(uint32_t hash, const void *data, size_t length) {
+    // FNV-1a
+    const uint8_t *bytes = data;
+    for (size_t i = 0; i < length; i++) {
+        hash = (hash ^ bytes[i]) * 16777619;
+    }
+    return hash;
+}
+
+static void harness_reset(void) {
+    // Let every remembered hit expire, it takes two steps as hits only age out on the task after they reach UINT16_MAX
+    for (uint8_t i = 0; i < 2; i++) {
+        advance_time(UINT16_MAX);
+        harness_matrix_task();
+    }
+
+    // Restart the clock and the random generators, so that each effect renders the same frames whatever ran before
+    set_time(0);
+    srand(1);
+    random16_set_seed(1337);
+#ifdef HARNESS_FRAME_BUFFER
+    memset(HARNESS_FRAME_BUFFER, 0, sizeof(HARNESS_FRAME_BUFFER));
+#endif
+    // Through the matrix rather than straight to the frame, so that the effects that only render what changed know
+    harness_matrix_set_all_off();
+    harness_matrix_defaults();
+}
+
+void effects_harness_run(uint8_t mode, uint32_t frames, effects_harness_result_t *result) {
+    harness_reset();
+    harness_matrix_mode(mode);
+
+    memset(result, 0, sizeof(*result));
+    result->hash = 2166136261;
+
+    for (uint32_t i = 0; i < frames; i++) {
+        frames_run = i;
+        if (i % 4 == 0) {
+            uint8_t key = (i / 4 * 7) % KEY_COUNT;
+            harness_matrix_press(key / MATRIX_COLS, key % MATRIX_COLS);
+        }
+
+        uint32_t flushed = frames_flushed;
+        uint64_t start   = harness_cycles();
+        while (frames_flushed == flushed) {
+            harness_matrix_task();
+        }
+        result->cycles += harness_cycles() - start;
+        result->hash       = harness_hash(result->hash, frame, sizeof(frame));
+        result->last_frame = harness_hash(2166136261, frame, sizeof(frame));
+        result->frames++;
+
+        advance_time(HARNESS_FLUSH_LIMIT);
+    }
+}
+
+void effects_harness_set_indicators(uint32_t frames) {
+    indicator_frames = frames;
+}
+
+uint8_t effects_harness_led_count(void) {
+    return HARNESS_LED_COUNT;
+}
+
+uint8_t effects_harness_effect_count(void) {
+    return HARNESS_EFFECT_MAX;
+}
+
+const char *effects_harness_effect_name(uint8_t mode) {
+    return mode < HARNESS_EFFECT_MAX ? effect_names[mode] : "UNKNOWN";
+}
@@ -0,0 +1,47 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Host side harness for the RGB Matrix and LED Matrix effects.
+ *
+ * Runs whichever of rgb_matrix and led_matrix is enabled on a fake driver and
+ * a generated g_led_config: one LED per key on a grid, the rest as underglow
+ * along the edges, see effects_harness_config.h. Each flushed frame is
+ * hashed, so that changes to the effects and their runners can be checked
+ * against known good output, and the time spent in the matrix task is
+ * counted to compare their speed. */
+
+typedef struct effects_harness_result_t {
+    uint32_t hash;       // Hash of every frame rendered, in order.
+    uint32_t last_frame; // Hash of the last frame alone.
+    uint32_t frames;     // Frames flushed to the driver.
+    uint64_t cycles;     // Spent in the matrix task, in effects_harness_cycle_unit().
+} effects_harness_result_t;
+
+/* Known good hash of the frames an effect renders in effects_tests.cpp, see
+ * rgb_matrix_golden.h and led_matrix_golden.h. */
+typedef struct effects_harness_golden_t {
+    uint8_t     led_count;
+    const char *effect;
+    uint32_t    hash;
+} effects_harness_golden_t;
+
+void effects_harness_init(void);
+
+/* Renders `frames` frames of `mode` from a clean state, tapping a key every few
+ * frames for the reactive effects. The result only depends on the arguments,
+ * not on which effects ran before. */
+void effects_harness_run(uint8_t mode, uint32_t frames, effects_harness_result_t *result);
+
+/* Has the indicators light up every third key over the first `frames` frames
+ * of the following runs, none by default. */
+void effects_harness_set_indicators(uint32_t frames);
+
+uint8_t     effects_harness_led_count(void);
+uint8_t     effects_harness_effect_count(void);
+const char *effects_harness_effect_name(uint8_t mode);
+const char *effects_harness_cycle_unit(void);
@@ -0,0 +1,102 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+// Config for platforms/test/effects_harness.c, for whichever of RGB Matrix and LED Matrix is enabled
+#if defined(RGB_MATRIX_ENABLE)
+#    ifndef RGB_MATRIX_LED_COUNT
+#        define RGB_MATRIX_LED_COUNT 60
+#    endif
+#    define EFFECTS_HARNESS_LED_COUNT RGB_MATRIX_LED_COUNT
+#else
+#    ifndef LED_MATRIX_LED_COUNT
+#        define LED_MATRIX_LED_COUNT 60
+#    endif
+#    define EFFECTS_HARNESS_LED_COUNT LED_MATRIX_LED_COUNT
+#endif
+
+// Two thirds of the LEDs sit under keys, the rest are a ring of underglow
+#if EFFECTS_HARNESS_LED_COUNT <= 60
+#    define MATRIX_ROWS 4
+#    define MATRIX_COLS 10
+#elif EFFECTS_HARNESS_LED_COUNT <= 120
+#    define MATRIX_ROWS 5
+#    define MATRIX_COLS 16
+#else
+#    define MATRIX_ROWS 8
+#    define MATRIX_COLS 20
+#endif
+
+#if defined(RGB_MATRIX_ENABLE)
+#    define RGB_MATRIX_KEYPRESSES
+#    define RGB_MATRIX_FRAMEBUFFER_EFFECTS
+
+#    define ENABLE_RGB_MATRIX_ALPHAS_MODS
+#    define ENABLE_RGB_MATRIX_GRADIENT_UP_DOWN
+#    define ENABLE_RGB_MATRIX_GRADIENT_LEFT_RIGHT
+#    define ENABLE_RGB_MATRIX_BREATHING
+#    define ENABLE_RGB_MATRIX_BAND_SAT
+#    define ENABLE_RGB_MATRIX_BAND_VAL
+#    define ENABLE_RGB_MATRIX_BAND_PINWHEEL_SAT
+#    define ENABLE_RGB_MATRIX_BAND_PINWHEEL_VAL
+#    define ENABLE_RGB_MATRIX_BAND_SPIRAL_SAT
+#    define ENABLE_RGB_MATRIX_BAND_SPIRAL_VAL
+#    define ENABLE_RGB_MATRIX_CYCLE_ALL
+#    define ENABLE_RGB_MATRIX_CYCLE_LEFT_RIGHT
+#    define ENABLE_RGB_MATRIX_CYCLE_UP_DOWN
+#    define ENABLE_RGB_MATRIX_RAINBOW_MOVING_CHEVRON
+#    define ENABLE_RGB_MATRIX_CYCLE_OUT_IN
+#    define ENABLE_RGB_MATRIX_CYCLE_OUT_IN_DUAL
+#    define ENABLE_RGB_MATRIX_CYCLE_PINWHEEL
+#    define ENABLE_RGB_MATRIX_CYCLE_SPIRAL
+#    define ENABLE_RGB_MATRIX_DUAL_BEACON
+#    define ENABLE_RGB_MATRIX_RAINBOW_BEACON
+#    define ENABLE_RGB_MATRIX_RAINBOW_PINWHEELS
+#    define ENABLE_RGB_MATRIX_RAINDROPS
+#    define ENABLE_RGB_MATRIX_JELLYBEAN_RAINDROPS
+#    define ENABLE_RGB_MATRIX_HUE_BREATHING
+#    define ENABLE_RGB_MATRIX_HUE_PENDULUM
+#    define ENABLE_RGB_MATRIX_HUE_WAVE
+#    define ENABLE_RGB_MATRIX_PIXEL_RAIN
+#    define ENABLE_RGB_MATRIX_PIXEL_FLOW
+#    define ENABLE_RGB_MATRIX_PIXEL_FRACTAL
+#    define ENABLE_RGB_MATRIX_TYPING_HEATMAP
+#    define ENABLE_RGB_MATRIX_DIGITAL_RAIN
+#    define ENABLE_RGB_MATRIX_SOLID_REACTIVE_SIMPLE
+#    define ENABLE_RGB_MATRIX_SOLID_REACTIVE
+#    define ENABLE_RGB_MATRIX_SOLID_REACTIVE_WIDE
+#    define ENABLE_RGB_MATRIX_SOLID_REACTIVE_MULTIWIDE
+#    define ENABLE_RGB_MATRIX_SOLID_REACTIVE_CROSS
+#    define ENABLE_RGB_MATRIX_SOLID_REACTIVE_MULTICROSS
+#    define ENABLE_RGB_MATRIX_SOLID_REACTIVE_NEXUS
+#    define ENABLE_RGB_MATRIX_SOLID_REACTIVE_MULTINEXUS
+#    define ENABLE_RGB_MATRIX_SPLASH
+#    define ENABLE_RGB_MATRIX_MULTISPLASH
+#    define ENABLE_RGB_MATRIX_SOLID_SPLASH
+#    define ENABLE_RGB_MATRIX_SOLID_MULTISPLASH
+#else
+#    define LED_MATRIX_KEYPRESSES
+#    define LED_MATRIX_FRAMEBUFFER_EFFECTS
+
+#    define ENABLE_LED_MATRIX_ALPHAS_MODS
+#    define ENABLE_LED_MATRIX_BREATHING
+#    define ENABLE_LED_MATRIX_BAND
+#    define ENABLE_LED_MATRIX_BAND_PINWHEEL
+#    define ENABLE_LED_MATRIX_BAND_SPIRAL
+#    define ENABLE_LED_MATRIX_CYCLE_LEFT_RIGHT
+#    define ENABLE_LED_MATRIX_CYCLE_UP_DOWN
+#    define ENABLE_LED_MATRIX_CYCLE_OUT_IN
+#    define ENABLE_LED_MATRIX_DUAL_BEACON
+#    define ENABLE_LED_MATRIX_SOLID_REACTIVE_SIMPLE
+#    define ENABLE_LED_MATRIX_SOLID_REACTIVE_WIDE
+#    define ENABLE_LED_MATRIX_SOLID_REACTIVE_MULTIWIDE
+#    define ENABLE_LED_MATRIX_SOLID_REACTIVE_CROSS
+#    define ENABLE_LED_MATRIX_SOLID_REACTIVE_MULTICROSS
+#    define ENABLE_LED_MATRIX_SOLID_REACTIVE_NEXUS
+#    define ENABLE_LED_MATRIX_SOLID_REACTIVE_MULTINEXUS
+#    define ENABLE_LED_MATRIX_SOLID_SPLASH
+#    define ENABLE_LED_MATRIX_SOLID_MULTISPLASH
+#    define ENABLE_LED_MATRIX_WAVE_LEFT_RIGHT
+#    define ENABLE_LED_MATRIX_WAVE_UP_DOWN
+#endif
@@ -0,0 +1,117 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+#include <stdio.h>
+#include <string.h>
+
+extern "C" {
+#include "effects_harness.h"
+
+// Stand-ins for the rest of the keyboard, which the benchmarks in tests/bench have for real
+bool is_keyboard_master(void) {
+    return true;
+}
+
+bool eeconfig_is_enabled(void) {
+    return true;
+}
+
+void eeconfig_init(void) {}
+
+// The config always starts from the defaults
+void eeprom_read_block(void *buf, const void *addr, size_t len) {
+    memset(buf, 0, len);
+}
+
+void eeprom_update_block(const void *buf, void *addr, size_t len) {}
+}
+
+#if defined(RGB_MATRIX_ENABLE)
+#    include "rgb_matrix_golden.h"
+#else
+#    include "led_matrix_golden.h"
+#endif
+
+// About two seconds of animation, with 32 key taps
+#define FRAMES 128
+
+static std::string golden_entry(const char *effect, uint32_t hash) {
+    char entry[64];
+    snprintf(entry, sizeof(entry), "{%u, \"%s\", 0x%08x},", effects_harness_led_count(), effect, hash);
+    return entry;
+}
+
+static const effects_harness_golden_t *find_golden(const char *effect) {
+    for (const effects_harness_golden_t &golden : effects_golden) {
+        if (golden.led_count == effects_harness_led_count() && strcmp(golden.effect, effect) == 0) {
+            return &golden;
+        }
+    }
+    return nullptr;
+}
+
+class MatrixEffect : public ::testing::TestWithParam<int> {
+   protected:
+    static void SetUpTestSuite() {
+        effects_harness_init();
+    }
+};
+
+TEST_P(MatrixEffect, MatchesGoldenFrames) {
+    const char *name = effects_harness_effect_name(GetParam());
+
+    effects_harness_result_t result;
+    effects_harness_run(GetParam(), FRAMES, &result);
+    ASSERT_EQ(result.frames, FRAMES);
+
+    double per_frame = (double)result.cycles / result.frames;
+    printf("[ RENDER   ] %s: %.0f %s/frame, %.1f %s/LED\n", name, per_frame, effects_harness_cycle_unit(), per_frame / effects_harness_led_count(), effects_harness_cycle_unit());
+    RecordProperty(std::string(effects_harness_cycle_unit()) + "_per_frame", std::to_string((uint64_t)per_frame));
+
+    // On purpose changes to an effect need a new entry in the golden table, printed here
+    const effects_harness_golden_t *golden = find_golden(name);
+    ASSERT_NE(golden, nullptr) << "No golden hash, add " << golden_entry(name, result.hash);
+    EXPECT_EQ(golden->hash, result.hash) << "Output changed, the new entry is " << golden_entry(name, result.hash);
+}
+
+INSTANTIATE_TEST_SUITE_P(Effects, MatrixEffect, ::testing::Range<int>(1, effects_harness_effect_count()), [](const ::testing::TestParamInfo<int> &info) { return std::string(effects_harness_effect_name(info.param)); });
+
+// The effects that only render the LEDs that changed, which have to notice the indicators writing over them
+class MatrixSparseEffect : public ::testing::TestWithParam<const char *> {
+   protected:
+    static void SetUpTestSuite() {
+        effects_harness_init();
+    }
+
+    void TearDown() override {
+        effects_harness_set_indicators(0);
+    }
+};
+
+TEST_P(MatrixSparseEffect, RendersOverIndicators) {
+    int mode = 1;
+    while (mode < effects_harness_effect_count() && strcmp(effects_harness_effect_name(mode), GetParam()) != 0) {
+        mode++;
+    }
+    ASSERT_LT(mode, effects_harness_effect_count());
+
+    // Some effects carry state over from one run to the next, so both runs follow a run of the same effect
+    effects_harness_result_t plain;
+    effects_harness_run(mode, FRAMES, &plain);
+    effects_harness_run(mode, FRAMES, &plain);
+
+    // Once the indicators stop, the effect has to show through again
+    effects_harness_result_t indicated;
+    effects_harness_set_indicators(FRAMES / 2);
+    effects_harness_run(mode, FRAMES, &indicated);
+    EXPECT_NE(plain.hash, indicated.hash);
+    EXPECT_EQ(plain.last_frame, indicated.last_frame);
+}
+
+#if defined(RGB_MATRIX_ENABLE)
+INSTANTIATE_TEST_SUITE_P(Effects, MatrixSparseEffect, ::testing::Values("SOLID_REACTIVE_SIMPLE", "SOLID_REACTIVE", "SOLID_REACTIVE_WIDE", "SOLID_REACTIVE_MULTIWIDE", "SOLID_REACTIVE_CROSS", "SOLID_REACTIVE_MULTICROSS", "SOLID_REACTIVE_NEXUS", "SOLID_REACTIVE_MULTINEXUS", "SPLASH", "MULTISPLASH", "SOLID_SPLASH", "SOLID_MULTISPLASH", "TYPING_HEATMAP"), [](const ::testing::TestParamInfo<const char *> &info) { return std::string(info.param); });
+#else
+INSTANTIATE_TEST_SUITE_P(Effects, MatrixSparseEffect, ::testing::Values("SOLID_REACTIVE_SIMPLE", "SOLID_REACTIVE_WIDE", "SOLID_REACTIVE_MULTIWIDE", "SOLID_REACTIVE_CROSS", "SOLID_REACTIVE_MULTICROSS", "SOLID_REACTIVE_NEXUS", "SOLID_REACTIVE_MULTINEXUS", "SOLID_SPLASH", "SOLID_MULTISPLASH"), [](const ::testing::TestParamInfo<const char *> &info) { return std::string(info.param); });
+#endif
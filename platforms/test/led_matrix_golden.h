@@ -0,0 +1,76 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "effects_harness.h"
+
+/* Hashes of the frames each LED Matrix effect renders in effects_tests.cpp,
+ * per layout size. */
+// clang-format off
+static const effects_harness_golden_t effects_golden[] = {
+    {60, "SOLID", 0xb220e3c5},
+    {60, "ALPHAS_MODS", 0xcf9f33c5},
+    {60, "BREATHING", 0x8a0852ad},
+    {60, "BAND", 0xa5568415},
+    {60, "BAND_PINWHEEL", 0x6a51681f},
+    {60, "BAND_SPIRAL", 0x486c094a},
+    {60, "CYCLE_LEFT_RIGHT", 0x79b4096d},
+    {60, "CYCLE_UP_DOWN", 0x15988c61},
+    {60, "CYCLE_OUT_IN", 0xbcef953d},
+    {60, "DUAL_BEACON", 0xe6411870},
+    {60, "SOLID_REACTIVE_SIMPLE", 0x5db2221d},
+    {60, "SOLID_REACTIVE_WIDE", 0x1181679d},
+    {60, "SOLID_REACTIVE_MULTIWIDE", 0xbe8eed87},
+    {60, "SOLID_REACTIVE_CROSS", 0x8f72a2ee},
+    {60, "SOLID_REACTIVE_MULTICROSS", 0xe0904e79},
+    {60, "SOLID_REACTIVE_NEXUS", 0xe90acae2},
+    {60, "SOLID_REACTIVE_MULTINEXUS", 0xdcc53d69},
+    {60, "SOLID_SPLASH", 0xa508a887},
+    {60, "SOLID_MULTISPLASH", 0xfa30e363},
+    {60, "WAVE_LEFT_RIGHT", 0x3c56d39d},
+    {60, "WAVE_UP_DOWN", 0x14d90f1d},
+    {120, "SOLID", 0xd07529c5},
+    {120, "ALPHAS_MODS", 0xa2213dc5},
+    {120, "BREATHING", 0x0513e515},
+    {120, "BAND", 0xec30d2bd},
+    {120, "BAND_PINWHEEL", 0x2486c9b6},
+    {120, "BAND_SPIRAL", 0x217dc191},
+    {120, "CYCLE_LEFT_RIGHT", 0xa598029b},
+    {120, "CYCLE_UP_DOWN", 0x9c2d48d1},
+    {120, "CYCLE_OUT_IN", 0x22153c2d},
+    {120, "DUAL_BEACON", 0x70b378f5},
+    {120, "SOLID_REACTIVE_SIMPLE", 0xde8299fd},
+    {120, "SOLID_REACTIVE_WIDE", 0xec4386b7},
+    {120, "SOLID_REACTIVE_MULTIWIDE", 0x2f07c177},
+    {120, "SOLID_REACTIVE_CROSS", 0x7383ffd8},
+    {120, "SOLID_REACTIVE_MULTICROSS", 0x97fe71ff},
+    {120, "SOLID_REACTIVE_NEXUS", 0xbd1f568b},
+    {120, "SOLID_REACTIVE_MULTINEXUS", 0xc5f4ba80},
+    {120, "SOLID_SPLASH", 0x8b352bf3},
+    {120, "SOLID_MULTISPLASH", 0x1f92a897},
+    {120, "WAVE_LEFT_RIGHT", 0xd764808e},
+    {120, "WAVE_UP_DOWN", 0x56cefc3c},
+    {240, "SOLID", 0xd50db5c5},
+    {240, "ALPHAS_MODS", 0x74dc16c5},
+    {240, "BREATHING", 0xf83b2505},
+    {240, "BAND", 0x31da222d},
+    {240, "BAND_PINWHEEL", 0xff14a152},
+    {240, "BAND_SPIRAL", 0x94456478},
+    {240, "CYCLE_LEFT_RIGHT", 0xc74d253f},
+    {240, "CYCLE_UP_DOWN", 0x9fca48d5},
+    {240, "CYCLE_OUT_IN", 0x4c8aa82d},
+    {240, "DUAL_BEACON", 0x2a5f7371},
+    {240, "SOLID_REACTIVE_SIMPLE", 0xe68f779d},
+    {240, "SOLID_REACTIVE_WIDE", 0x9e799476},
+    {240, "SOLID_REACTIVE_MULTIWIDE", 0x3395780e},
+    {240, "SOLID_REACTIVE_CROSS", 0xe969ac30},
+    {240, "SOLID_REACTIVE_MULTICROSS", 0x7c1f53ff},
+    {240, "SOLID_REACTIVE_NEXUS", 0x51d125da},
+    {240, "SOLID_REACTIVE_MULTINEXUS", 0xc260d1af},
+    {240, "SOLID_SPLASH", 0x4c87acb3},
+    {240, "SOLID_MULTISPLASH", 0x28d04f15},
+    {240, "WAVE_LEFT_RIGHT", 0x6af0a762},
+    {240, "WAVE_UP_DOWN", 0xa150f51e},
+};
+// clang-format on
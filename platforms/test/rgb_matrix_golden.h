@@ -0,0 +1,147 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "effects_harness.h"
+
+/* Hashes of the frames each RGB Matrix effect renders in effects_tests.cpp,
+ * per layout size. */
+// clang-format off
+static const effects_harness_golden_t effects_golden[] = {
+    {60, "SOLID_COLOR", 0x00f317c5},
+    {60, "ALPHAS_MODS", 0x4c3c67c5},
+    {60, "GRADIENT_UP_DOWN", 0xed87f9c5},
+    {60, "GRADIENT_LEFT_RIGHT", 0x7955c1c5},
+    {60, "BREATHING", 0xc74427dd},
+    {60, "BAND_SAT", 0x72c9ca61},
+    {60, "BAND_VAL", 0xcd012585},
+    {60, "BAND_PINWHEEL_SAT", 0x968bf403},
+    {60, "BAND_PINWHEEL_VAL", 0xc959c093},
+    {60, "BAND_SPIRAL_SAT", 0x9906b60f},
+    {60, "BAND_SPIRAL_VAL", 0xabec9b38},
+    {60, "CYCLE_ALL", 0xf62000ed},
+    {60, "CYCLE_LEFT_RIGHT", 0xf69c22ad},
+    {60, "CYCLE_UP_DOWN", 0xb52786b9},
+    {60, "RAINBOW_MOVING_CHEVRON", 0xc7d87265},
+    {60, "CYCLE_OUT_IN", 0x59378f25},
+    {60, "CYCLE_OUT_IN_DUAL", 0x88d26039},
+    {60, "CYCLE_PINWHEEL", 0x15095207},
+    {60, "CYCLE_SPIRAL", 0xd56abec1},
+    {60, "DUAL_BEACON", 0x88ebf01b},
+    {60, "RAINBOW_BEACON", 0x06dfae51},
+    {60, "RAINBOW_PINWHEELS", 0xbfee1615},
+    {60, "RAINDROPS", 0xbc553c75},
+    {60, "JELLYBEAN_RAINDROPS", 0x9ac237de},
+    {60, "HUE_BREATHING", 0x34295345},
+    {60, "HUE_PENDULUM", 0x58e191cf},
+    {60, "HUE_WAVE", 0xe34189a5},
+    {60, "PIXEL_RAIN", 0xed40731c},
+    {60, "PIXEL_FLOW", 0x28132c45},
+    {60, "PIXEL_FRACTAL", 0x1eafd5a1},
+    {60, "TYPING_HEATMAP", 0x584e75ee},
+    {60, "DIGITAL_RAIN", 0x6bb98308},
+    {60, "SOLID_REACTIVE_SIMPLE", 0x7bdd7905},
+    {60, "SOLID_REACTIVE", 0x2d138111},
+    {60, "SOLID_REACTIVE_WIDE", 0x01674edb},
+    {60, "SOLID_REACTIVE_MULTIWIDE", 0xdfde3c89},
+    {60, "SOLID_REACTIVE_CROSS", 0x6ff7c7e5},
+    {60, "SOLID_REACTIVE_MULTICROSS", 0x7d107d39},
+    {60, "SOLID_REACTIVE_NEXUS", 0x83b046f9},
+    {60, "SOLID_REACTIVE_MULTINEXUS", 0x5e864a0e},
+    {60, "SPLASH", 0x94d78e6c},
+    {60, "MULTISPLASH", 0x1719bae1},
+    {60, "SOLID_SPLASH", 0x774a7396},
+    {60, "SOLID_MULTISPLASH", 0x35377d30},
+
+    {120, "SOLID_COLOR", 0x06d991c5},
+    {120, "ALPHAS_MODS", 0xde4519c5},
+    {120, "GRADIENT_UP_DOWN", 0x2a6e35c5},
+    {120, "GRADIENT_LEFT_RIGHT", 0x0732c0c5},
+    {120, "BREATHING", 0xd568ea75},
+    {120, "BAND_SAT", 0xa44b354f},
+    {120, "BAND_VAL", 0xc43b8485},
+    {120, "BAND_PINWHEEL_SAT", 0xb715b3a8},
+    {120, "BAND_PINWHEEL_VAL", 0x30ed666c},
+    {120, "BAND_SPIRAL_SAT", 0x44d9ec8f},
+    {120, "BAND_SPIRAL_VAL", 0xa392d6c1},
+    {120, "CYCLE_ALL", 0x1f9e30a5},
+    {120, "CYCLE_LEFT_RIGHT", 0x248940bd},
+    {120, "CYCLE_UP_DOWN", 0xd5054a69},
+    {120, "RAINBOW_MOVING_CHEVRON", 0xd60634e9},
+    {120, "CYCLE_OUT_IN", 0xb1396df9},
+    {120, "CYCLE_OUT_IN_DUAL", 0x0ff9aed1},
+    {120, "CYCLE_PINWHEEL", 0x37763b29},
+    {120, "CYCLE_SPIRAL", 0x8345e6c5},
+    {120, "DUAL_BEACON", 0x487b8681},
+    {120, "RAINBOW_BEACON", 0x376381e3},
+    {120, "RAINBOW_PINWHEELS", 0xa1cd33a5},
+    {120, "RAINDROPS", 0xec61fad3},
+    {120, "JELLYBEAN_RAINDROPS", 0x57821f48},
+    {120, "HUE_BREATHING", 0x172855c5},
+    {120, "HUE_PENDULUM", 0x367a7001},
+    {120, "HUE_WAVE", 0x79bcda2d},
+    {120, "PIXEL_RAIN", 0x5e0e19ca},
+    {120, "PIXEL_FLOW", 0x4048ad55},
+    {120, "PIXEL_FRACTAL", 0x5f446cc7},
+    {120, "TYPING_HEATMAP", 0x2b2d7862},
+    {120, "DIGITAL_RAIN", 0xb5170038},
+    {120, "SOLID_REACTIVE_SIMPLE", 0x2f70c785},
+    {120, "SOLID_REACTIVE", 0x36e4fb59},
+    {120, "SOLID_REACTIVE_WIDE", 0xeee2c818},
+    {120, "SOLID_REACTIVE_MULTIWIDE", 0xe9edee2b},
+    {120, "SOLID_REACTIVE_CROSS", 0xec4a4457},
+    {120, "SOLID_REACTIVE_MULTICROSS", 0xa3343505},
+    {120, "SOLID_REACTIVE_NEXUS", 0x0da79e90},
+    {120, "SOLID_REACTIVE_MULTINEXUS", 0x32058091},
+    {120, "SPLASH", 0x25508045},
+    {120, "MULTISPLASH", 0x83bbfc77},
+    {120, "SOLID_SPLASH", 0x5ba53f79},
+    {120, "SOLID_MULTISPLASH", 0x2f4d9000},
+
+    {240, "SOLID_COLOR", 0xa4d685c5},
+    {240, "ALPHAS_MODS", 0x0fadebc5},
+    {240, "GRADIENT_UP_DOWN", 0xba58e5c5},
+    {240, "GRADIENT_LEFT_RIGHT", 0x9fd019c5},
+    {240, "BREATHING", 0xc4ce5b05},
+    {240, "BAND_SAT", 0x85d976bf},
+    {240, "BAND_VAL", 0x7cf782a5},
+    {240, "BAND_PINWHEEL_SAT", 0x7808ef09},
+    {240, "BAND_PINWHEEL_VAL", 0x7b863c60},
+    {240, "BAND_SPIRAL_SAT", 0x9292befa},
+    {240, "BAND_SPIRAL_VAL", 0x8edbbcfa},
+    {240, "CYCLE_ALL", 0x4d784fa5},
+    {240, "CYCLE_LEFT_RIGHT", 0xf5b4c86d},
+    {240, "CYCLE_UP_DOWN", 0xa20518bd},
+    {240, "RAINBOW_MOVING_CHEVRON", 0x388204f9},
+    {240, "CYCLE_OUT_IN", 0x1ffe97e5},
+    {240, "CYCLE_OUT_IN_DUAL", 0xcee128e5},
+    {240, "CYCLE_PINWHEEL", 0x1a2ea173},
+    {240, "CYCLE_SPIRAL", 0x6345b081},
+    {240, "DUAL_BEACON", 0x37745e5f},
+    {240, "RAINBOW_BEACON", 0x81028247},
+    {240, "RAINBOW_PINWHEELS", 0xadec4f7d},
+    {240, "RAINDROPS", 0x31d03f89},
+    {240, "JELLYBEAN_RAINDROPS", 0x1b8fd896},
+    {240, "HUE_BREATHING", 0x6068b145},
+    {240, "HUE_PENDULUM", 0xeb415cc7},
+    {240, "HUE_WAVE", 0xf05ec425},
+    {240, "PIXEL_RAIN", 0xba66a8ba},
+    {240, "PIXEL_FLOW", 0xa9960335},
+    {240, "PIXEL_FRACTAL", 0xeaffd565},
+    {240, "TYPING_HEATMAP", 0x1d33786d},
+    {240, "DIGITAL_RAIN", 0xe4b2c225},
+    {240, "SOLID_REACTIVE_SIMPLE", 0xc144fc85},
+    {240, "SOLID_REACTIVE", 0xce75be41},
+    {240, "SOLID_REACTIVE_WIDE", 0xf6a23a46},
+    {240, "SOLID_REACTIVE_MULTIWIDE", 0x3d31c819},
+    {240, "SOLID_REACTIVE_CROSS", 0x460b5cda},
+    {240, "SOLID_REACTIVE_MULTICROSS", 0xef7f3516},
+    {240, "SOLID_REACTIVE_NEXUS", 0x4e23c809},
+    {240, "SOLID_REACTIVE_MULTINEXUS", 0x94c4d218},
+    {240, "SPLASH", 0x77389584},
+    {240, "MULTISPLASH", 0x92a6ed43},
+    {240, "SOLID_SPLASH", 0x7b89bf77},
+    {240, "SOLID_MULTISPLASH", 0x3b13a45b},
+};
+// clang-format on
@@ -23,3 +23,74 @@ eeprom_legacy_emulated_flash_SRC := \
 	$(PLATFORM_PATH)/chibios/drivers/eeprom/eeprom_legacy_emulated_flash.c
 eeprom_legacy_emulated_flash_tiny_SRC := $(eeprom_legacy_emulated_flash_SRC)
 eeprom_legacy_emulated_flash_large_SRC := $(eeprom_legacy_emulated_flash_SRC)
+
+split_link_DEFS := -DSPLIT_KEYBOARD -DSPLIT_COMMON_TRANSACTIONS
+split_link_INC := $(QUANTUM_PATH)/split_common
+split_link_CONFIG := $(PLATFORM_PATH)/$(PLATFORM_KEY)/split_link_config.h
+
+split_link_SRC := \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/split_link.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/split_link_tests.cpp \
+	$(PLATFORM_PATH)/synchronization_util.c \
+	$(QUANTUM_PATH)/split_common/transactions.c \
+	$(QUANTUM_PATH)/split_common/transport.c \
+	$(QUANTUM_PATH)/sync_timer.c \
+	$(QUANTUM_PATH)/crc.c
+
+rgb_matrix_60_DEFS := -DNO_DEBUG -DEEPROM_TEST_HARNESS -DRGB_MATRIX_ENABLE -DRGB_MATRIX_LED_COUNT=60
+rgb_matrix_120_DEFS := -DNO_DEBUG -DEEPROM_TEST_HARNESS -DRGB_MATRIX_ENABLE -DRGB_MATRIX_LED_COUNT=120
+rgb_matrix_240_DEFS := -DNO_DEBUG -DEEPROM_TEST_HARNESS -DRGB_MATRIX_ENABLE -DRGB_MATRIX_LED_COUNT=240
+# The typing heatmap searches for the neighbours of each key at 60 LEDs, has them all in its table at 120,
+# and only some of them at 240, so that each way has to match the same golden frames
+rgb_matrix_120_DEFS += -DRGB_MATRIX_TYPING_HEATMAP_NEIGHBOURS=2048
+rgb_matrix_240_DEFS += -DRGB_MATRIX_TYPING_HEATMAP_NEIGHBOURS=256
+
+rgb_matrix_60_CONFIG := $(PLATFORM_PATH)/$(PLATFORM_KEY)/effects_harness_config.h
+rgb_matrix_120_CONFIG := $(rgb_matrix_60_CONFIG)
+rgb_matrix_240_CONFIG := $(rgb_matrix_60_CONFIG)
+
+rgb_matrix_60_INC := \
+	$(QUANTUM_PATH)/rgb_matrix \
+	$(QUANTUM_PATH)/rgb_matrix/animations \
+	$(QUANTUM_PATH)/rgb_matrix/animations/runners
+rgb_matrix_120_INC := $(rgb_matrix_60_INC)
+rgb_matrix_240_INC := $(rgb_matrix_60_INC)
+
+rgb_matrix_60_SRC := \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/effects_harness.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/effects_tests.cpp \
+	$(QUANTUM_PATH)/rgb_matrix/rgb_matrix.c \
+	$(QUANTUM_PATH)/led_render.c \
+	$(QUANTUM_PATH)/color.c \
+	$(QUANTUM_PATH)/sync_timer.c \
+	$(LIB_PATH)/lib8tion/lib8tion.c
+rgb_matrix_120_SRC := $(rgb_matrix_60_SRC)
+rgb_matrix_240_SRC := $(rgb_matrix_60_SRC)
+
+led_matrix_60_DEFS := -DNO_DEBUG -DEEPROM_TEST_HARNESS -DLED_MATRIX_ENABLE -DLED_MATRIX_LED_COUNT=60
+led_matrix_120_DEFS := -DNO_DEBUG -DEEPROM_TEST_HARNESS -DLED_MATRIX_ENABLE -DLED_MATRIX_LED_COUNT=120
+led_matrix_240_DEFS := -DNO_DEBUG -DEEPROM_TEST_HARNESS -DLED_MATRIX_ENABLE -DLED_MATRIX_LED_COUNT=240
+
+led_matrix_60_CONFIG := $(rgb_matrix_60_CONFIG)
+led_matrix_120_CONFIG := $(rgb_matrix_60_CONFIG)
+led_matrix_240_CONFIG := $(rgb_matrix_60_CONFIG)
+
+led_matrix_60_INC := \
+	$(QUANTUM_PATH)/led_matrix \
+	$(QUANTUM_PATH)/led_matrix/animations \
+	$(QUANTUM_PATH)/led_matrix/animations/runners
+led_matrix_120_INC := $(led_matrix_60_INC)
+led_matrix_240_INC := $(led_matrix_60_INC)
+
+led_matrix_60_SRC := \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/effects_harness.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/effects_tests.cpp \
+	$(QUANTUM_PATH)/led_matrix/led_matrix.c \
+	$(QUANTUM_PATH)/led_render.c \
+	$(QUANTUM_PATH)/sync_timer.c \
+	$(LIB_PATH)/lib8tion/lib8tion.c
+led_matrix_120_SRC := $(led_matrix_60_SRC)
+led_matrix_240_SRC := $(led_matrix_60_SRC)
@@ -0,0 +1,296 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "split_link.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+
+#include "serial.h"
+#include "timer.h"
+#include "transactions.h"
+
+void advance_time(uint32_t ms);
+void set_time(uint32_t t);
+
+enum split_link_message_type {
+    SPLIT_LINK_TRANSACTION,
+    SPLIT_LINK_SLAVE_MATRIX,
+    SPLIT_LINK_QUIT,
+};
+
+typedef struct split_link_header_t {
+    uint8_t  type;
+    uint16_t length;
+    uint32_t time; // Master time, so that both halves agree on it
+} split_link_header_t;
+
+#define SPLIT_LINK_MAX_FRAME (1 + UINT8_MAX)
+
+static split_link_config_t link_config;
+static split_link_stats_t  link_stats;
+static uint64_t            link_time_us;
+static uint32_t            link_pending_us;
+static uint32_t            link_random;
+static int                 link_socket = -1;
+static pid_t               slave_pid   = -1;
+static bool                is_master   = true;
+
+////////////////////////////////////////////////////
+// Socket helpers
+
+static bool split_link_write(const void *data, size_t length) {
+    const uint8_t *bytes = data;
+    while (length > 0) {
+        ssize_t written = write(link_socket, bytes, length);
+        if (written <= 0) {
+            return false;
+        }
+        bytes += written;
+        length -= written;
+    }
+    return true;
+}
+
+static bool split_link_read(void *data, size_t length) {
+    uint8_t *bytes = data;
+    while (length > 0) {
+        ssize_t got = read(link_socket, bytes, length);
+        if (got <= 0) {
+            return false;
+        }
+        bytes += got;
+        length -= got;
+    }
+    return true;
+}
+
+static bool split_link_send_message(uint8_t type, const void *data, uint16_t length) {
+    split_link_header_t header = {.type = type, .length = length, .time = timer_read32()};
+    return split_link_write(&header, sizeof(header)) && split_link_write(data, length);
+}
+
+////////////////////////////////////////////////////
+// Slave process
+
+static void split_link_slave_loop(void) {
+    matrix_row_t master_matrix[(MATRIX_ROWS) / 2] = {0};
+    matrix_row_t slave_matrix[(MATRIX_ROWS) / 2]  = {0};
+    uint8_t      frame[SPLIT_LINK_MAX_FRAME];
+
+    split_link_header_t header;
+    while (split_link_read(&header, sizeof(header)) && header.type != SPLIT_LINK_QUIT) {
+        if (header.length > sizeof(frame) || !split_link_read(frame, header.length)) {
+            break;
+        }
+        set_time(header.time);
+
+        if (header.type == SPLIT_LINK_SLAVE_MATRIX) {
+            memcpy(slave_matrix, frame, sizeof(slave_matrix));
+            continue;
+        }
+
+        // The slave scans in between transactions, publishing its state to the shared memory
+        transactions_slave(master_matrix, slave_matrix);
+
+        uint8_t  reply[SPLIT_LINK_MAX_FRAME];
+        uint16_t reply_length = 0;
+
+        // A short or garbled request leaves the slave waiting, which the master sees as a timeout
+        uint8_t id = frame[0];
+        if (header.length > 0 && id < NUM_TOTAL_TRANSACTIONS && header.length == 1 + split_transaction_table[id].initiator2target_buffer_size) {
+            split_transaction_desc_t *trans = &split_transaction_table[id];
+            memcpy(split_trans_initiator2target_buffer(trans), &frame[1], trans->initiator2target_buffer_size);
+            if (trans->slave_callback) {
+                trans->slave_callback(trans->initiator2target_buffer_size, split_trans_initiator2target_buffer(trans), trans->target2initiator_buffer_size, split_trans_target2initiator_buffer(trans));
+            }
+
+            reply[0] = id ^ NUM_TOTAL_TRANSACTIONS;
+            memcpy(&reply[1], split_trans_target2initiator_buffer(trans), trans->target2initiator_buffer_size);
+            reply_length = 1 + trans->target2initiator_buffer_size;
+        }
+
+        if (!split_link_send_message(SPLIT_LINK_TRANSACTION, reply, reply_length)) {
+            break;
+        }
+    }
+}
+
+////////////////////////////////////////////////////
+// Link simulation, always applied on the master side
+
+static uint32_t split_link_rand(void) {
+    // xorshift32, so that runs are repeatable for a given seed
+    link_random ^= link_random << 13;
+    link_random ^= link_random >> 17;
+    link_random ^= link_random << 5;
+    return link_random;
+}
+
+static bool split_link_chance(uint32_t ppm) {
+    return ppm > 0 && split_link_rand() % 1000000 < ppm;
+}
+
+void split_link_advance_us(uint32_t us) {
+    link_time_us += us;
+    link_pending_us += us;
+    if (link_pending_us >= 1000) {
+        advance_time(link_pending_us / 1000);
+        link_pending_us %= 1000;
+    }
+}
+
+static void split_link_wire_time(uint32_t us) {
+    link_stats.elapsed_us += us;
+    split_link_advance_us(us);
+}
+
+// Sends the bytes across the wire, dropping and corrupting some on the way
+static uint16_t split_link_transfer(uint8_t *bytes, uint16_t length) {
+    uint16_t kept = 0;
+    for (uint16_t i = 0; i < length; i++) {
+        if (split_link_chance(link_config.drop_ppm)) {
+            continue;
+        }
+        bytes[kept] = bytes[i];
+        if (split_link_chance(link_config.corrupt_ppm)) {
+            bytes[kept] ^= 1 << (split_link_rand() % 8);
+        }
+        kept++;
+    }
+
+    link_stats.bytes += length;
+    split_link_wire_time(link_config.latency_us + (uint32_t)((uint64_t)length * link_config.bits_per_byte * 1000000 / link_config.baud));
+    return kept;
+}
+
+static bool split_link_fail(void) {
+    link_stats.failed++;
+    split_link_wire_time(link_config.timeout_us);
+    return false;
+}
+
+////////////////////////////////////////////////////
+// Split util API
+
+bool is_keyboard_master(void) {
+    return is_master;
+}
+
+bool is_transport_connected(void) {
+    return true;
+}
+
+////////////////////////////////////////////////////
+// Serial driver API
+
+void soft_serial_initiator_init(void) {}
+
+void soft_serial_target_init(void) {}
+
+bool soft_serial_transaction(int index) {
+    if (index < 0 || index >= NUM_TOTAL_TRANSACTIONS || link_socket < 0) {
+        return false;
+    }
+    link_stats.transactions++;
+
+    split_transaction_desc_t *trans = &split_transaction_table[index];
+    uint8_t                   frame[SPLIT_LINK_MAX_FRAME];
+
+    frame[0] = index;
+    memcpy(&frame[1], split_trans_initiator2target_buffer(trans), trans->initiator2target_buffer_size);
+    uint16_t length = split_link_transfer(frame, 1 + trans->initiator2target_buffer_size);
+
+    split_link_header_t header;
+    if (!split_link_send_message(SPLIT_LINK_TRANSACTION, frame, length) || !split_link_read(&header, sizeof(header)) || !split_link_read(frame, header.length)) {
+        fprintf(stderr, "split_link: slave went away\n");
+        abort();
+    }
+
+    // Nothing comes back if the slave did not understand the request
+    if (header.length == 0) {
+        return split_link_fail();
+    }
+
+    length = split_link_transfer(frame, header.length);
+    if (length < 1 + trans->target2initiator_buffer_size) {
+        return split_link_fail();
+    }
+    if (frame[0] != (index ^ NUM_TOTAL_TRANSACTIONS)) {
+        link_stats.failed++;
+        return false;
+    }
+
+    memcpy(split_trans_target2initiator_buffer(trans), &frame[1], trans->target2initiator_buffer_size);
+    return true;
+}
+
+////////////////////////////////////////////////////
+// Test API
+
+void split_link_start(const split_link_config_t *config) {
+    int sockets[2];
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, sockets) != 0) {
+        perror("split_link: socketpair");
+        abort();
+    }
+
+    // Don't let both processes flush the same buffered output
+    fflush(stdout);
+    fflush(stderr);
+
+    slave_pid = fork();
+    if (slave_pid < 0) {
+        perror("split_link: fork");
+        abort();
+    }
+
+    if (slave_pid == 0) {
+        close(sockets[0]);
+        link_socket = sockets[1];
+        is_master   = false;
+        split_link_slave_loop();
+        _exit(0);
+    }
+
+    close(sockets[1]);
+    link_socket = sockets[0];
+    split_link_configure(config);
+    split_link_reset_stats();
+}
+
+void split_link_stop(void) {
+    if (link_socket < 0) {
+        return;
+    }
+    split_link_send_message(SPLIT_LINK_QUIT, NULL, 0);
+    close(link_socket);
+    waitpid(slave_pid, NULL, 0);
+    link_socket = -1;
+    slave_pid   = -1;
+}
+
+void split_link_configure(const split_link_config_t *config) {
+    link_config = *config;
+    link_random = config->seed ? config->seed : 1;
+}
+
+void split_link_set_slave_matrix(const matrix_row_t *rows) {
+    split_link_send_message(SPLIT_LINK_SLAVE_MATRIX, rows, sizeof(matrix_row_t) * ((MATRIX_ROWS) / 2));
+}
+
+uint64_t split_link_time_us(void) {
+    return link_time_us;
+}
+
+const split_link_stats_t *split_link_stats(void) {
+    return &link_stats;
+}
+
+void split_link_reset_stats(void) {
+    memset(&link_stats, 0, sizeof(link_stats));
+}
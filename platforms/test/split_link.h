@@ -0,0 +1,57 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "matrix.h"
+
+/* Simulated split keyboard link for host side tests.
+ *
+ * split_link_start() forks a slave process connected to this one, the master,
+ * through a socket pair. Both run the regular split transactions on their own
+ * copy of the shared memory, while the link adds the time each transfer would
+ * take on the wire and injects faults on the master side. The master timer is
+ * advanced by the simulated link time, so throttled syncs behave as they would
+ * on hardware. */
+
+typedef struct split_link_config_t {
+    uint32_t baud;          // Bits per second on the wire.
+    uint8_t  bits_per_byte; // Start, data, parity and stop bits, 12 for the default 8E2 USART framing.
+    uint32_t latency_us;    // Added for each direction change on the wire.
+    uint32_t timeout_us;    // Time lost when a transfer comes up short.
+    uint32_t corrupt_ppm;   // Chance per million for a byte to get a bit flipped.
+    uint32_t drop_ppm;      // Chance per million for a byte to get lost.
+    uint32_t seed;          // Seed for the fault injection.
+} split_link_config_t;
+
+typedef struct split_link_stats_t {
+    uint32_t transactions; // Transactions started by the master.
+    uint32_t failed;       // Transactions that did not complete.
+    uint32_t bytes;        // Bytes sent over the wire in both directions.
+    uint64_t elapsed_us;   // Simulated time spent on the wire, including timeouts.
+} split_link_stats_t;
+
+#define SPLIT_LINK_DEFAULT_CONFIG \
+    { .baud = 230400, .bits_per_byte = 12, .latency_us = 20, .timeout_us = 20000, .corrupt_ppm = 0, .drop_ppm = 0, .seed = 1 }
+
+void split_link_start(const split_link_config_t *config);
+void split_link_stop(void);
+
+// Changes the link parameters without restarting the slave
+void split_link_configure(const split_link_config_t *config);
+
+// Sets the slave half matrix, picked up by the next transaction
+void split_link_set_slave_matrix(const matrix_row_t *rows);
+
+// Advances the master time by the given amount, e.g. for the time spent scanning
+void split_link_advance_us(uint32_t us);
+
+// Current master time in microseconds
+uint64_t split_link_time_us(void);
+
+const split_link_stats_t *split_link_stats(void);
+void                      split_link_reset_stats(void);
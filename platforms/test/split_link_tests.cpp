@@ -0,0 +1,147 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+
+// The transaction ids are checked with the C spelling of static_assert
+#define _Static_assert static_assert
+
+extern "C" {
+#include "split_link.h"
+#include "transactions.h"
+}
+
+#define ROWS_PER_SIDE ((MATRIX_ROWS) / 2)
+
+// Time the master spends scanning its own matrix between transactions
+#define SCAN_US 250
+
+static void sum_slave_handler(uint8_t in_buflen, const void *in_data, uint8_t out_buflen, void *out_data) {
+    const uint8_t *in  = (const uint8_t *)in_data;
+    uint8_t        sum = 0;
+    for (uint8_t i = 0; i < in_buflen; i++) {
+        sum += in[i];
+    }
+    *(uint8_t *)out_data = sum;
+}
+
+struct recovery {
+    uint32_t changes  = 0;
+    uint32_t resolved = 0;
+    uint64_t total_us = 0;
+    uint64_t max_us   = 0;
+};
+
+class SplitLink : public ::testing::Test {
+   protected:
+    matrix_row_t master_matrix[ROWS_PER_SIDE] = {0};
+    matrix_row_t slave_matrix[ROWS_PER_SIDE]  = {0};
+    matrix_row_t slave_state[ROWS_PER_SIDE]   = {0};
+
+    void start(split_link_config_t config) {
+        // Registered before forking, so that both halves know the RPC
+        transaction_register_rpc(USER_SUM, sum_slave_handler);
+        split_link_start(&config);
+    }
+
+    void TearDown() override {
+        split_link_stop();
+    }
+
+    void scan(void) {
+        transactions_master(master_matrix, slave_matrix);
+        split_link_advance_us(SCAN_US);
+    }
+
+    bool in_sync(void) {
+        return memcmp(slave_matrix, slave_state, sizeof(slave_state)) == 0;
+    }
+
+    // Flips a key on the slave and scans until the master has seen it. The master must
+    // only ever see the old or the new matrix, never a corrupted one.
+    void toggle_slave_key(uint8_t row, uint8_t col, recovery &stats, uint32_t max_scans) {
+        matrix_row_t previous[ROWS_PER_SIDE];
+        memcpy(previous, slave_state, sizeof(previous));
+
+        slave_state[row] ^= (matrix_row_t)1 << col;
+        split_link_set_slave_matrix(slave_state);
+        stats.changes++;
+
+        const uint64_t start = split_link_time_us();
+        for (uint32_t i = 0; i < max_scans; i++) {
+            scan();
+            if (in_sync()) {
+                uint64_t took = split_link_time_us() - start;
+                stats.resolved++;
+                stats.total_us += took;
+                stats.max_us = std::max(stats.max_us, took);
+                return;
+            }
+            ASSERT_EQ(memcmp(slave_matrix, previous, sizeof(previous)), 0) << "master accepted a corrupted slave matrix";
+        }
+    }
+
+    void run_key_changes(const char *name, uint32_t count, uint32_t max_scans) {
+        recovery stats;
+        for (uint32_t i = 0; i < count; i++) {
+            toggle_slave_key(i % ROWS_PER_SIDE, (i * 7) % MATRIX_COLS, stats, max_scans);
+            if (HasFatalFailure()) return;
+        }
+        const split_link_stats_t *link = split_link_stats();
+        printf("[ LINK     ] %s: %u/%u key changes seen, avg %llu us, max %llu us, %u/%u transactions failed\n", name, stats.resolved, stats.changes, (unsigned long long)(stats.total_us / std::max(stats.resolved, 1u)), (unsigned long long)stats.max_us, link->failed, link->transactions);
+        EXPECT_EQ(stats.resolved, stats.changes);
+    }
+};
+
+TEST_F(SplitLink, Throughput) {
+    static const uint32_t bauds[] = {19200, 38400, 57600, 115200, 230400, 460800};
+    for (uint32_t baud : bauds) {
+        split_link_config_t config = SPLIT_LINK_DEFAULT_CONFIG;
+        config.baud                = baud;
+        start(config);
+
+        for (int i = 0; i < 2000; i++) {
+            scan();
+        }
+
+        const split_link_stats_t *link = split_link_stats();
+        printf("[ LINK     ] %6u baud: %llu transactions/s, %llu bytes/s on the wire\n", baud, (unsigned long long)link->transactions * 1000000 / link->elapsed_us, (unsigned long long)link->bytes * 1000000 / link->elapsed_us);
+        EXPECT_EQ(link->failed, 0);
+        split_link_stop();
+    }
+}
+
+TEST_F(SplitLink, SlaveKeyLatency) {
+    start(SPLIT_LINK_DEFAULT_CONFIG);
+    run_key_changes("clean link", 200, 4);
+    EXPECT_EQ(split_link_stats()->failed, 0);
+}
+
+TEST_F(SplitLink, RecoversFromCorruptedBytes) {
+    split_link_config_t config = SPLIT_LINK_DEFAULT_CONFIG;
+    config.corrupt_ppm         = 5000;
+    start(config);
+    run_key_changes("0.5% corrupted bytes", 200, 1000);
+    EXPECT_GT(split_link_stats()->failed, 0);
+}
+
+TEST_F(SplitLink, RecoversFromDroppedBytes) {
+    split_link_config_t config = SPLIT_LINK_DEFAULT_CONFIG;
+    config.drop_ppm            = 5000;
+    start(config);
+    run_key_changes("0.5% dropped bytes", 200, 1000);
+    EXPECT_GT(split_link_stats()->failed, 0);
+}
+
+TEST_F(SplitLink, RemoteProcedureCall) {
+    start(SPLIT_LINK_DEFAULT_CONFIG);
+
+    uint8_t request[] = {1, 2, 3, 4};
+    uint8_t sum       = 0;
+    EXPECT_TRUE(transaction_rpc_exec(USER_SUM, sizeof(request), request, sizeof(sum), &sum));
+    EXPECT_EQ(sum, 10);
+}
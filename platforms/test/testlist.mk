@@ -1 +1 @@
-TEST_LIST += eeprom_legacy_emulated_flash_tiny eeprom_legacy_emulated_flash_large
+TEST_LIST += eeprom_legacy_emulated_flash_tiny eeprom_legacy_emulated_flash_large split_link rgb_matrix_60 rgb_matrix_120 rgb_matrix_240 led_matrix_60 led_matrix_120 led_matrix_240
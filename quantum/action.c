@@ -44,6 +44,10 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #    include "encoder.h"
 #endif
 
+#ifdef KEYSTROKE_TRACE_ENABLE
+#    include "keystroke_trace.h"
+#endif
+
 int tp_buttons;
 
 #if defined(RETRO_TAPPING) || defined(RETRO_TAPPING_PER_KEY) || (defined(AUTO_SHIFT_ENABLE) && defined(RETRO_SHIFT))
@@ -78,6 +82,9 @@ void action_exec(keyevent_t event) {
         ac_dprintf("\n");
 #if defined(RETRO_TAPPING) || defined(RETRO_TAPPING_PER_KEY) || (defined(AUTO_SHIFT_ENABLE) && defined(RETRO_SHIFT))
         retro_tapping_counter++;
+#endif
+#ifdef KEYSTROKE_TRACE_ENABLE
+        keystroke_trace_record(event);
 #endif
     }
 
@@ -134,6 +141,25 @@ void action_exec(keyevent_t event) {
 #endif
 }
 
+/** \brief Checks whether a tick event has any timeout to drive.
+ *
+ * Tick events only advance the tapping state machine and the oneshot
+ * timeouts, so they can be skipped while neither is pending.
+ */
+bool action_tick_pending(void) {
+#ifndef NO_ACTION_TAPPING
+    if (action_tapping_pending()) {
+        return true;
+    }
+#endif
+#if !defined(NO_ACTION_ONESHOT) && (defined(ONESHOT_TIMEOUT) && (ONESHOT_TIMEOUT > 0))
+    if (keymap_config.oneshot_enable && has_oneshot_timeout_pending()) {
+        return true;
+    }
+#endif
+    return false;
+}
+
 #ifdef SWAP_HANDS_ENABLE
 extern const keypos_t PROGMEM hand_swap_config[MATRIX_ROWS][MATRIX_COLS];
 #    ifdef ENCODER_MAP_ENABLE
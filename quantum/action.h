@@ -57,6 +57,7 @@ typedef struct {
 
 /* Execute action per keyevent */
 void action_exec(keyevent_t event);
+bool action_tick_pending(void);
 
 /* action for key */
 action_t action_for_key(uint8_t layer, keypos_t key);
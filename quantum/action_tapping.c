@@ -1,5 +1,6 @@
 #include <stdint.h>
 #include <stdbool.h>
+#include <string.h>
 
 #include "action.h"
 #include "action_layer.h"
@@ -16,10 +17,12 @@
 #    endif
 
 #    ifndef COMBO_ENABLE
-#        define IS_TAPPING_RECORD(r) (KEYEQ(tapping_key.event.key, (r->event.key)))
+#        define IS_SAME_KEY(a, b) (KEYEQ((a)->event.key, (b)->event.key))
 #    else
-#        define IS_TAPPING_RECORD(r) (KEYEQ(tapping_key.event.key, (r->event.key)) && tapping_key.keycode == r->keycode)
+// Combo events all come from key (0, 0), their keycode tells them apart from that key
+#        define IS_SAME_KEY(a, b) (KEYEQ((a)->event.key, (b)->event.key) && (a)->keycode == (b)->keycode)
 #    endif
+#    define IS_TAPPING_RECORD(r) IS_SAME_KEY(&tapping_key, r)
 #    define WITHIN_TAPPING_TERM(e) (TIMER_DIFF_16(e.time, tapping_key.event.time) < GET_TAPPING_TERM(get_record_keycode(&tapping_key, false), &tapping_key))
 #    define WITHIN_QUICK_TAP_TERM(e) (TIMER_DIFF_16(e.time, tapping_key.event.time) < GET_QUICK_TAP_TERM(get_record_keycode(&tapping_key, false), &tapping_key))
 
@@ -61,13 +64,30 @@ __attribute__((weak)) bool get_hold_on_other_key_press(uint16_t keycode, keyreco
 
 static keyrecord_t tapping_key                         = {};
 static keyrecord_t waiting_buffer[WAITING_BUFFER_SIZE] = {};
-static uint8_t     waiting_buffer_head                 = 0;
 static uint8_t     waiting_buffer_tail                 = 0;
+static uint8_t     waiting_buffer_count                = 0;
+// Buffered press events, in total and bucketed by key so lookups don't have to walk the buffer
+static uint8_t waiting_buffer_presses                                 = 0;
+static uint8_t waiting_buffer_key_presses[WAITING_BUFFER_KEY_BUCKETS] = {};
+#    ifdef ACTION_TAPPING_STATS
+static uint16_t waiting_buffer_overflows  = 0;
+static uint16_t waiting_buffer_forced     = 0;
+static uint8_t  waiting_buffer_high_water = 0;
+#    endif
+
+_Static_assert(WAITING_BUFFER_SIZE > 0 && WAITING_BUFFER_SIZE < 256, "WAITING_BUFFER_SIZE must be between 1 and 255");
+_Static_assert((WAITING_BUFFER_KEY_BUCKETS & (WAITING_BUFFER_KEY_BUCKETS - 1)) == 0, "WAITING_BUFFER_KEY_BUCKETS must be a power of 2");
+
+#    define WAITING_BUFFER_INDEX(i) ((uint8_t)((waiting_buffer_tail + (i)) % WAITING_BUFFER_SIZE))
+#    define WAITING_BUFFER_BUCKET(k) (((k).col ^ ((k).row << 2) ^ ((k).row >> 3)) & (WAITING_BUFFER_KEY_BUCKETS - 1))
 
 static bool process_tapping(keyrecord_t *record);
 static bool waiting_buffer_enq(keyrecord_t record);
+static void waiting_buffer_deq(void);
+static void waiting_buffer_process(void);
+static bool waiting_buffer_force_decision(void);
 static void waiting_buffer_clear(void);
-static bool waiting_buffer_typed(keyevent_t event);
+static bool waiting_buffer_typed(const keyrecord_t *record);
 static bool waiting_buffer_has_anykey_pressed(void);
 static void waiting_buffer_scan_tap(void);
 static void debug_tapping_key(void);
@@ -85,9 +105,12 @@ void action_tapping_process(keyrecord_t record) {
             ac_dprintf("\n");
         }
     } else {
-        if (!waiting_buffer_enq(record)) {
-            // clear all in case of overflow.
+        if (!waiting_buffer_enq(record) && !(waiting_buffer_force_decision() && waiting_buffer_enq(record))) {
+            // clear all in case of overflow, only reachable if forcing a decision couldn't free a slot.
             ac_dprintf("OVERFLOW: CLEAR ALL STATES\n");
+#    ifdef ACTION_TAPPING_STATS
+            waiting_buffer_overflows++;
+#    endif
             clear_keyboard();
             waiting_buffer_clear();
             tapping_key = (keyrecord_t){0};
@@ -95,23 +118,37 @@ void action_tapping_process(keyrecord_t record) {
     }
 
     // process waiting_buffer
-    if (IS_EVENT(record.event) && waiting_buffer_head != waiting_buffer_tail) {
+    if (IS_EVENT(record.event) && waiting_buffer_count) {
         ac_dprintf("---- action_exec: process waiting_buffer -----\n");
     }
-    for (; waiting_buffer_tail != waiting_buffer_head; waiting_buffer_tail = (waiting_buffer_tail + 1) % WAITING_BUFFER_SIZE) {
-        if (process_tapping(&waiting_buffer[waiting_buffer_tail])) {
-            ac_dprintf("processed: waiting_buffer[%u] =", waiting_buffer_tail);
-            debug_record(waiting_buffer[waiting_buffer_tail]);
-            ac_dprintf("\n\n");
-        } else {
-            break;
-        }
-    }
+    waiting_buffer_process();
     if (IS_EVENT(record.event)) {
         ac_dprintf("\n");
     }
 }
 
+/** \brief Is the tapping state machine waiting on a timeout
+ *
+ * Tick events only matter while a tapping key is being tracked, or while events are still held in the waiting buffer.
+ */
+bool action_tapping_pending(void) {
+    return IS_EVENT(tapping_key.event) || waiting_buffer_count;
+}
+
+#    ifdef ACTION_TAPPING_STATS
+uint16_t waiting_buffer_overflow_count(void) {
+    return waiting_buffer_overflows;
+}
+
+uint16_t waiting_buffer_forced_decision_count(void) {
+    return waiting_buffer_forced;
+}
+
+uint8_t waiting_buffer_high_water_mark(void) {
+    return waiting_buffer_high_water;
+}
+#    endif
+
 /* Some conditionally defined helper macros to keep process_tapping more
  * readable. The conditional definition of tapping_keycode and all the
  * conditional uses of it are hidden inside macros named TAP_...
@@ -219,7 +256,7 @@ bool process_tapping(keyrecord_t *keyp) {
                 // clang-format off
                 else if (
                     (
-                        !event.pressed && waiting_buffer_typed(event) &&
+                        !event.pressed && waiting_buffer_typed(keyp) &&
                         TAP_GET_PERMISSIVE_HOLD
                     )
                     // Causes nested taps to not wait past TAPPING_TERM/RETRO_SHIFT
@@ -237,7 +274,7 @@ bool process_tapping(keyrecord_t *keyp) {
                             || (
                                 TAP_IS_RETRO
                                 && (event.key.col != tapping_key.event.key.col || event.key.row != tapping_key.event.key.row)
-                                && !event.pressed && waiting_buffer_typed(event)
+                                && !event.pressed && waiting_buffer_typed(keyp)
                             )
                         )
                     )
@@ -254,7 +291,7 @@ bool process_tapping(keyrecord_t *keyp) {
                  * Without this unexpected repeating will occur with having fast repeating setting
                  * https://github.com/tmk/tmk_keyboard/issues/60
                  */
-                else if (!event.pressed && !waiting_buffer_typed(event)) {
+                else if (!event.pressed && !waiting_buffer_typed(keyp)) {
                     // Modifier/Layer should be retained till end of this tapping.
                     action_t action = layer_switch_get_action(event.key);
                     switch (action.kind.id) {
@@ -441,42 +478,112 @@ bool process_tapping(keyrecord_t *keyp) {
 
 /** \brief Waiting buffer enq
  *
- * FIXME: Needs docs
+ * Appends a record to the waiting buffer, returns false if the buffer is full.
  */
 bool waiting_buffer_enq(keyrecord_t record) {
     if (IS_NOEVENT(record.event)) {
         return true;
     }
 
-    if ((waiting_buffer_head + 1) % WAITING_BUFFER_SIZE == waiting_buffer_tail) {
+    if (waiting_buffer_count == WAITING_BUFFER_SIZE) {
         ac_dprintf("waiting_buffer_enq: Over flow.\n");
         return false;
     }
 
-    waiting_buffer[waiting_buffer_head] = record;
-    waiting_buffer_head                 = (waiting_buffer_head + 1) % WAITING_BUFFER_SIZE;
+    waiting_buffer[WAITING_BUFFER_INDEX(waiting_buffer_count)] = record;
+    waiting_buffer_count++;
+    if (record.event.pressed) {
+        waiting_buffer_presses++;
+        waiting_buffer_key_presses[WAITING_BUFFER_BUCKET(record.event.key)]++;
+    }
+#    ifdef ACTION_TAPPING_STATS
+    if (waiting_buffer_count > waiting_buffer_high_water) {
+        waiting_buffer_high_water = waiting_buffer_count;
+    }
+#    endif
 
     ac_dprintf("waiting_buffer_enq: ");
     debug_waiting_buffer();
     return true;
 }
 
+/** \brief Waiting buffer deq
+ *
+ * Drops the oldest record from the waiting buffer.
+ */
+static void waiting_buffer_deq(void) {
+    const keyevent_t event = waiting_buffer[waiting_buffer_tail].event;
+    if (event.pressed) {
+        waiting_buffer_presses--;
+        waiting_buffer_key_presses[WAITING_BUFFER_BUCKET(event.key)]--;
+    }
+    waiting_buffer_tail = WAITING_BUFFER_INDEX(1);
+    waiting_buffer_count--;
+}
+
+/** \brief Waiting buffer process
+ *
+ * Replays buffered records in order until the tapping state machine asks to keep waiting.
+ */
+static void waiting_buffer_process(void) {
+    while (waiting_buffer_count) {
+        if (!process_tapping(&waiting_buffer[waiting_buffer_tail])) {
+            break;
+        }
+        ac_dprintf("processed: waiting_buffer[%u] =", waiting_buffer_tail);
+        debug_record(waiting_buffer[waiting_buffer_tail]);
+        ac_dprintf("\n\n");
+        waiting_buffer_deq();
+    }
+}
+
+/** \brief Waiting buffer force decision
+ *
+ * Called when the waiting buffer is full. Events only pile up while a tapping key is pressed and
+ * undecided, and its release would already have made it a tap, so settle it as a hold the same way
+ * TAPPING_TERM expiring would, then replay the buffer to make room. Returns true if a slot was freed.
+ */
+static bool waiting_buffer_force_decision(void) {
+    if (IS_NOEVENT(tapping_key.event)) {
+        return false;
+    }
+
+    ac_dprintf("OVERFLOW: FORCE HOLD\n");
+#    ifdef ACTION_TAPPING_STATS
+    waiting_buffer_forced++;
+#    endif
+    if (tapping_key.event.pressed && tapping_key.tap.count == 0) {
+        process_record(&tapping_key);
+    }
+    tapping_key = (keyrecord_t){0};
+    debug_tapping_key();
+    waiting_buffer_process();
+    return waiting_buffer_count < WAITING_BUFFER_SIZE;
+}
+
 /** \brief Waiting buffer clear
  *
- * FIXME: Needs docs
+ * Drops every buffered record.
  */
 void waiting_buffer_clear(void) {
-    waiting_buffer_head = 0;
-    waiting_buffer_tail = 0;
+    waiting_buffer_tail    = 0;
+    waiting_buffer_count   = 0;
+    waiting_buffer_presses = 0;
+    memset(waiting_buffer_key_presses, 0, sizeof(waiting_buffer_key_presses));
 }
 
 /** \brief Waiting buffer typed
  *
- * FIXME: Needs docs
+ * Checks whether the opposite event of the same key is buffered, i.e. whether the key was typed while waiting.
+ * Callers ask about releases, for which the per-bucket press counter rules out most keys without walking the buffer.
  */
-bool waiting_buffer_typed(keyevent_t event) {
-    for (uint8_t i = waiting_buffer_tail; i != waiting_buffer_head; i = (i + 1) % WAITING_BUFFER_SIZE) {
-        if (KEYEQ(event.key, waiting_buffer[i].event.key) && event.pressed != waiting_buffer[i].event.pressed) {
+bool waiting_buffer_typed(const keyrecord_t *record) {
+    if (!record->event.pressed && !waiting_buffer_key_presses[WAITING_BUFFER_BUCKET(record->event.key)]) {
+        return false;
+    }
+    for (uint8_t i = 0; i < waiting_buffer_count; i++) {
+        const keyrecord_t *candidate = &waiting_buffer[WAITING_BUFFER_INDEX(i)];
+        if (IS_SAME_KEY(record, candidate) && record->event.pressed != candidate->event.pressed) {
             return true;
         }
     }
@@ -485,13 +592,10 @@ bool waiting_buffer_typed(keyevent_t event) {
 
 /** \brief Waiting buffer has anykey pressed
  *
- * FIXME: Needs docs
+ * Checks whether any press event is buffered.
  */
 __attribute__((unused)) bool waiting_buffer_has_anykey_pressed(void) {
-    for (uint8_t i = waiting_buffer_tail; i != waiting_buffer_head; i = (i + 1) % WAITING_BUFFER_SIZE) {
-        if (waiting_buffer[i].event.pressed) return true;
-    }
-    return false;
+    return waiting_buffer_presses;
 }
 
 /** \brief Scan buffer for tapping
@@ -506,9 +610,10 @@ void waiting_buffer_scan_tap(void) {
         return;
     }
 
-    for (uint8_t i = waiting_buffer_tail; i != waiting_buffer_head; i = (i + 1) % WAITING_BUFFER_SIZE) {
+    for (uint8_t n = 0; n < waiting_buffer_count; n++) {
+        uint8_t      i         = WAITING_BUFFER_INDEX(n);
         keyrecord_t *candidate = &waiting_buffer[i];
-        if (IS_EVENT(candidate->event) && KEYEQ(candidate->event.key, tapping_key.event.key) && !candidate->event.pressed && WITHIN_TAPPING_TERM(candidate->event)) {
+        if (IS_EVENT(candidate->event) && IS_TAPPING_RECORD(candidate) && !candidate->event.pressed && WITHIN_TAPPING_TERM(candidate->event)) {
             tapping_key.tap.count = 1;
             candidate->tap.count  = 1;
             process_record(&tapping_key);
@@ -536,9 +641,9 @@ static void debug_tapping_key(void) {
  */
 static void debug_waiting_buffer(void) {
     ac_dprintf("{ ");
-    for (uint8_t i = waiting_buffer_tail; i != waiting_buffer_head; i = (i + 1) % WAITING_BUFFER_SIZE) {
-        ac_dprintf("[%u]=", i);
-        debug_record(waiting_buffer[i]);
+    for (uint8_t n = 0; n < waiting_buffer_count; n++) {
+        ac_dprintf("[%u]=", WAITING_BUFFER_INDEX(n));
+        debug_record(waiting_buffer[WAITING_BUFFER_INDEX(n)]);
         ac_dprintf(" ");
     }
     ac_dprintf("}\n");
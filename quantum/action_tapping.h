@@ -32,12 +32,29 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #    define TAPPING_TOGGLE 5
 #endif
 
-#define WAITING_BUFFER_SIZE 8
+/* number of events held back while a tap-hold decision is pending */
+#ifndef WAITING_BUFFER_SIZE
+#    define WAITING_BUFFER_SIZE 8
+#endif
+
+/* number of buckets used to index buffered presses by key, power of 2 */
+#ifndef WAITING_BUFFER_KEY_BUCKETS
+#    define WAITING_BUFFER_KEY_BUCKETS 16
+#endif
 
 #ifndef NO_ACTION_TAPPING
 uint16_t get_record_keycode(keyrecord_t *record, bool update_layer_cache);
 uint16_t get_event_keycode(keyevent_t event, bool update_layer_cache);
 void     action_tapping_process(keyrecord_t record);
+bool     action_tapping_pending(void);
+#    ifdef ACTION_TAPPING_STATS
+// Number of times the waiting buffer overflowed and all tapping state was dropped
+uint16_t waiting_buffer_overflow_count(void);
+// Number of times a full waiting buffer forced the pending tap-hold decision
+uint16_t waiting_buffer_forced_decision_count(void);
+// Largest number of events the waiting buffer has held at once
+uint8_t waiting_buffer_high_water_mark(void);
+#    endif
 #endif
 
 uint16_t get_tapping_term(uint16_t keycode, keyrecord_t *record);
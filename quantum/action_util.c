@@ -250,6 +250,24 @@ bool is_oneshot_enabled(void) {
     return keymap_config.oneshot_enable;
 }
 
+#    if (defined(ONESHOT_TIMEOUT) && (ONESHOT_TIMEOUT > 0))
+/** \brief Is a oneshot timeout pending
+ *
+ * True while any oneshot mods, layer or swap hands state could still time out.
+ */
+bool has_oneshot_timeout_pending(void) {
+    if (get_oneshot_mods() || (get_oneshot_layer_state() && !(get_oneshot_layer_state() & ONESHOT_TOGGLED))) {
+        return true;
+    }
+#        ifdef SWAP_HANDS_ENABLE
+    if (swap_hands_oneshot == SHO_ACTIVE) {
+        return true;
+    }
+#        endif
+    return false;
+}
+#    endif
+
 #endif
 
 /** \brief Send keyboard report
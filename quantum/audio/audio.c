@@ -76,11 +76,10 @@ bool state_changed  = false; // global flag, which is set if anything changes wi
 float (*notes_pointer)[][2];                           // SONG, an array of MUSICAL_NOTEs
 uint16_t notes_count;                                  // length of the notes_pointer array
 bool     notes_repeat;                                 // PLAY_SONG or PLAY_LOOP?
-uint16_t melody_current_note_duration = 0;             // duration of the currently playing note from the active melody, in ms
-uint8_t  note_tempo                   = TEMPO_DEFAULT; // beats-per-minute
-uint16_t current_note                 = 0;             // index into the array at notes_pointer
-bool     note_resting                 = false;         // if a short pause was introduced between two notes with the same frequency while playing a melody
-uint16_t last_timestamp               = 0;
+uint32_t melody_note_deadline = 0;                     // timer_read32 timestamp at which the currently playing note from the active melody ends
+uint8_t  note_tempo           = TEMPO_DEFAULT;         // beats-per-minute
+uint16_t current_note         = 0;                     // index into the array at notes_pointer
+bool     note_resting         = false;                 // if a short pause was introduced between two notes with the same frequency while playing a melody
 
 #ifdef AUDIO_ENABLE_TONE_MULTIPLEXING
 #    ifndef AUDIO_MAX_SIMULTANEOUS_TONES
@@ -153,8 +152,6 @@ void audio_startup(void) {
     if (audio_config.enable) {
         PLAY_SONG(startup_song);
     }
-
-    last_timestamp = timer_read();
 }
 
 void audio_toggle(void) {
@@ -202,8 +199,6 @@ void audio_stop_all(void) {
     playing_melody = false;
     playing_note   = false;
 
-    melody_current_note_duration = 0;
-
     for (uint8_t i = 0; i < AUDIO_TONE_STACKSIZE; i++) {
         tones[i] = (musical_tone_t){.time_started = 0, .pitch = -1.0f, .duration = 0};
     }
@@ -329,9 +324,9 @@ void audio_play_melody(float (*np)[][2], uint16_t n_count, bool n_repeat) {
 
     // start first note manually, which also starts the audio_driver
     // all following/remaining notes are played by 'audio_update_state'
-    audio_play_note((*notes_pointer)[current_note][0], audio_duration_to_ms((*notes_pointer)[current_note][1]));
-    last_timestamp               = timer_read();
-    melody_current_note_duration = audio_duration_to_ms((*notes_pointer)[current_note][1]);
+    uint16_t duration    = audio_duration_to_ms((*notes_pointer)[current_note][1]);
+    melody_note_deadline = timer_read32() + duration;
+    audio_play_note((*notes_pointer)[current_note][0], duration);
 }
 
 float click[2][2];
@@ -402,76 +397,80 @@ bool audio_update_state(void) {
     }
 
     bool     goto_next_note = false;
-    uint16_t current_time   = timer_read();
-
-    if (playing_melody) {
-        goto_next_note = timer_elapsed(last_timestamp) >= melody_current_note_duration;
-        if (goto_next_note) {
-            uint16_t delta         = timer_elapsed(last_timestamp) - melody_current_note_duration;
-            last_timestamp         = current_time;
-            uint16_t previous_note = current_note;
-            current_note++;
-            voices_timer = timer_read(); // reset to zero, for the effects added by voices.c
-
-            if (current_note >= notes_count) {
-                if (notes_repeat) {
-                    current_note = 0;
-                } else {
-                    audio_stop_all();
-                    return false;
-                }
-            }
+    uint32_t now            = timer_read32();
 
-            if (!note_resting && (*notes_pointer)[previous_note][0] == (*notes_pointer)[current_note][0]) {
-                note_resting = true;
+    // a melody only needs attention once the current note's deadline has passed
+    if (playing_melody && timer_expired32(now, melody_note_deadline)) {
+        goto_next_note = true;
 
-                // special handling for successive notes of the same frequency:
-                // insert a short pause to separate them audibly
-                audio_play_note(0.0f, audio_duration_to_ms(2));
-                current_note                 = previous_note;
-                melody_current_note_duration = audio_duration_to_ms(2);
+        // how far we've over shot the deadline
+        uint32_t delta         = now - melody_note_deadline;
+        uint16_t previous_note = current_note;
+        current_note++;
+        voices_timer = timer_read(); // reset to zero, for the effects added by voices.c
 
+        if (current_note >= notes_count) {
+            if (notes_repeat) {
+                current_note = 0;
             } else {
-                note_resting = false;
-
-                // TODO: handle glissando here (or remember previous and current tone)
-                /* there would need to be a freq(here we are) -> freq(next note)
-                 * and do slide/glissando in between problem here is to know which
-                 * frequency on the stack relates to what other? e.g. a melody starts
-                 * tones in a sequence, and stops expiring one, so the most recently
-                 * stopped is the starting point for a glissando to the most recently started?
-                 * how to detect and preserve this relation?
-                 * and what about user input, chords, ...?
-                 */
-
-                // '- delta': Skip forward in the next note's length if we've over shot
-                //            the last, so the overall length of the song is the same
-                uint16_t duration = audio_duration_to_ms((*notes_pointer)[current_note][1]);
-
-                // Skip forward past any completely missed notes
-                while (delta > duration && current_note < notes_count - 1) {
-                    delta -= duration;
-                    current_note++;
-                    duration = audio_duration_to_ms((*notes_pointer)[current_note][1]);
-                }
+                audio_stop_all();
+                return false;
+            }
+        }
 
-                if (delta < duration) {
-                    duration -= delta;
-                } else {
-                    // Only way to get here is if it is the last note and
-                    // we have completely missed it. Play it for 1ms...
-                    duration = 1;
-                }
+        if (!note_resting && (*notes_pointer)[previous_note][0] == (*notes_pointer)[current_note][0]) {
+            note_resting = true;
+
+            // special handling for successive notes of the same frequency:
+            // insert a short pause to separate them audibly
+            uint16_t pause = audio_duration_to_ms(2);
+            audio_play_note(0.0f, pause);
+            current_note = previous_note;
+            melody_note_deadline += pause;
+
+        } else {
+            note_resting = false;
+
+            // TODO: handle glissando here (or remember previous and current tone)
+            /* there would need to be a freq(here we are) -> freq(next note)
+             * and do slide/glissando in between problem here is to know which
+             * frequency on the stack relates to what other? e.g. a melody starts
+             * tones in a sequence, and stops expiring one, so the most recently
+             * stopped is the starting point for a glissando to the most recently started?
+             * how to detect and preserve this relation?
+             * and what about user input, chords, ...?
+             */
+
+            // the deadlines are kept relative to the start of the melody, so when
+            // we've over shot the last note the next one is shortened by as much,
+            // and the overall length of the song stays the same
+            uint16_t duration = audio_duration_to_ms((*notes_pointer)[current_note][1]);
+
+            // Skip forward past any completely missed notes
+            while (delta > duration && current_note < notes_count - 1) {
+                delta -= duration;
+                melody_note_deadline += duration;
+                current_note++;
+                duration = audio_duration_to_ms((*notes_pointer)[current_note][1]);
+            }
+            melody_note_deadline += duration;
 
-                audio_play_note((*notes_pointer)[current_note][0], duration);
-                melody_current_note_duration = duration;
+            if (delta < duration) {
+                duration -= delta;
+            } else {
+                // Only way to get here is if it is the last note and
+                // we have completely missed it. Play it for 1ms...
+                duration             = 1;
+                melody_note_deadline = now + duration;
             }
+
+            audio_play_note((*notes_pointer)[current_note][0], duration);
         }
     }
 
     if (playing_note) {
 #ifdef AUDIO_ENABLE_TONE_MULTIPLEXING
-        tone_multiplexing_index_shift = (int)(current_time / tone_multiplexing_rate) % MIN(AUDIO_MAX_SIMULTANEOUS_TONES, active_tones);
+        tone_multiplexing_index_shift = (int)(timer_read() / tone_multiplexing_rate) % MIN(AUDIO_MAX_SIMULTANEOUS_TONES, active_tones);
         goto_next_note                = true;
 #endif
         if (vibrato || glissando) {
@@ -547,20 +546,13 @@ void audio_decrease_tempo(uint8_t tempo_change) {
         note_tempo -= tempo_change;
 }
 
-// TODO in the int-math version are some bugs; songs sometimes abruptly end - maybe an issue with the timer/system-tick wrapping around?
+// integer math on all platforms, so advancing a melody doesn't need the FPU (or a soft-float library) in the timer callbacks
 uint16_t audio_duration_to_ms(uint16_t duration_bpm) {
-#if defined(__AVR__)
-    // doing int-math saves us some bytes in the overall firmware size, but the intermediate result is less accurate before being cast to/returned as uint
-    return ((uint32_t)duration_bpm * 60 * 1000) / (64 * note_tempo);
-    // NOTE: beware of uint16_t overflows when note_tempo is low and/or the duration is long
-#else
-    return ((float)duration_bpm * 60) / (64 * note_tempo) * 1000;
-#endif
+    // 64 units per beat; the intermediate result fits 32bit for any duration and tempo
+    uint32_t duration_ms = ((uint32_t)duration_bpm * 60 * 1000) / (64 * note_tempo);
+    // long notes at slow tempos last more than a minute, hold them as long as a uint16_t allows
+    return duration_ms > UINT16_MAX ? UINT16_MAX : duration_ms;
 }
 uint16_t audio_ms_to_duration(uint16_t duration_ms) {
-#if defined(__AVR__)
     return ((uint32_t)duration_ms * 64 * note_tempo) / 60 / 1000;
-#else
-    return ((float)duration_ms * 64 * note_tempo) / 60 / 1000;
-#endif
 }
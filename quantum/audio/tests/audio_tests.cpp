@@ -0,0 +1,115 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+#include <utility>
+#include <vector>
+
+extern "C" {
+#include "musical_notes.h"
+#include "driver_mock.h"
+
+void set_time(uint32_t t);
+void advance_time(uint32_t ms);
+}
+
+typedef std::pair<uint32_t, float> note_change;
+
+class AudioMelody : public ::testing::Test {
+   protected:
+    uint32_t start = 0;
+
+    void SetUp() override {
+        audio_init();
+        audio_stop_all();
+        audio_set_tempo(TEMPO_DEFAULT);
+        set_time(start);
+    }
+
+    template <size_t N>
+    void play(float (&song)[N][2]) {
+        audio_play_melody((float(*)[][2])song, N, false);
+    }
+
+    // steps the audio state in 1ms increments, recording each time the most recent tone changes, until the melody ends
+    std::vector<note_change> run_for(uint32_t ms) {
+        std::vector<note_change> changes = {{0, audio_get_frequency(0)}};
+        for (uint32_t t = 1; t <= ms && audio_is_playing_melody(); t++) {
+            advance_time(1);
+            audio_update_state();
+            if (audio_get_frequency(0) != changes.back().second) {
+                changes.push_back({t, audio_get_frequency(0)});
+            }
+        }
+        return changes;
+    }
+};
+
+TEST_F(AudioMelody, DurationsAreConvertedAtTheCurrentTempo) {
+    EXPECT_EQ(audio_duration_to_ms(64), 500);
+    EXPECT_EQ(audio_ms_to_duration(500), 64);
+
+    audio_set_tempo(60);
+    EXPECT_EQ(audio_duration_to_ms(16), 250);
+    audio_set_tempo(10);
+    EXPECT_EQ(audio_duration_to_ms(1), 93);
+    // durations beyond what fits in milliseconds are clamped rather than wrapping around
+    EXPECT_EQ(audio_duration_to_ms(699), 65531);
+    EXPECT_EQ(audio_duration_to_ms(700), UINT16_MAX);
+    EXPECT_EQ(audio_duration_to_ms(UINT16_MAX), UINT16_MAX);
+    EXPECT_EQ(audio_ms_to_duration(UINT16_MAX), 699);
+
+    // the longest time at the fastest tempo doesn't overflow going back
+    audio_set_tempo(255);
+    EXPECT_EQ(audio_duration_to_ms(UINT16_MAX), UINT16_MAX);
+    EXPECT_EQ(audio_ms_to_duration(UINT16_MAX), 17825);
+}
+
+TEST_F(AudioMelody, NotesFollowTheSchedule) {
+    float song[][2] = SONG(Q__NOTE(_A4), Q__NOTE(_C5), H__NOTE(_E5));
+    play(song);
+
+    std::vector<note_change> expected = {{0, NOTE_A4}, {125, NOTE_C5}, {250, NOTE_E5}, {500, 0.0f}};
+    EXPECT_EQ(run_for(1000), expected);
+    EXPECT_FALSE(audio_is_playing_melody());
+}
+
+TEST_F(AudioMelody, RepeatedNotesAreSeparatedByAPause) {
+    float song[][2] = SONG(Q__NOTE(_A4), Q__NOTE(_A4), Q__NOTE(_C5));
+    play(song);
+
+    // the pause delays the rest of the song by its duration
+    uint16_t                 pause    = audio_duration_to_ms(2);
+    std::vector<note_change> expected = {{0, NOTE_A4}, {125, 0.0f}, {125 + pause, NOTE_A4}, {250 + pause, NOTE_C5}, {375 + pause, 0.0f}};
+    EXPECT_EQ(run_for(1000), expected);
+}
+
+TEST_F(AudioMelody, MissedNotesAreSkipped) {
+    float song[][2] = SONG(Q__NOTE(_A4), Q__NOTE(_C5), Q__NOTE(_E5), Q__NOTE(_G5), Q__NOTE(_A5));
+    play(song);
+
+    // stall for the whole second note and part of the third
+    advance_time(300);
+    audio_update_state();
+    EXPECT_EQ(audio_get_frequency(0), NOTE_E5);
+
+    // the schedule is kept, the fourth note starts when it would have anyway
+    std::vector<note_change> expected = {{0, NOTE_E5}, {75, NOTE_G5}, {200, NOTE_A5}, {325, 0.0f}};
+    EXPECT_EQ(run_for(1000), expected);
+}
+
+TEST_F(AudioMelody, LateUpdatesDoNotStretchTheSong) {
+    float song[][2] = SONG(E__NOTE(_A4), E__NOTE(_C5), E__NOTE(_E5), E__NOTE(_G5));
+    play(song);
+
+    // a driver updating the state every 16ms, like the pwm drivers
+    uint32_t elapsed = 0;
+    while (audio_is_playing_melody() && elapsed < 1000) {
+        advance_time(16);
+        elapsed += 16;
+        audio_update_state();
+    }
+    // four notes of 62ms end by 248ms, which is seen on the next update
+    EXPECT_EQ(elapsed, 256);
+}
@@ -0,0 +1,23 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "driver_mock.h"
+
+uint16_t driver_starts = 0;
+uint16_t driver_stops  = 0;
+
+void audio_driver_initialize(void) {}
+
+void audio_driver_start(void) {
+    driver_starts++;
+}
+
+void audio_driver_stop(void) {
+    driver_stops++;
+}
+
+void eeconfig_update_audio(uint8_t val) {}
+
+void audio_on_user(void) {}
+
+void audio_off_user(void) {}
@@ -0,0 +1,21 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+extern uint16_t driver_starts;
+extern uint16_t driver_stops;
+
+// the parts of audio.h the tests need, which can't be included from C++ through quantum.h
+void     audio_init(void);
+void     audio_play_melody(float (*np)[][2], uint16_t n_count, bool n_repeat);
+void     audio_stop_all(void);
+bool     audio_update_state(void);
+bool     audio_is_playing_melody(void);
+float    audio_get_frequency(uint8_t tone_index);
+void     audio_set_tempo(uint8_t tempo);
+uint16_t audio_duration_to_ms(uint16_t duration_bpm);
+uint16_t audio_ms_to_duration(uint16_t duration_ms);
@@ -0,0 +1,14 @@
+# The letter case of these variables might seem odd. However:
+# - it is consistent with the example that is used as a reference in the Unit Testing article (https://docs.qmk.fm/#/unit_testing?id=adding-tests-for-new-or-existing-features)
+# - Neither `make test:audio` or `make test:AUDIO` work when using SCREAMING_SNAKE_CASE
+
+audio_DEFS := -DMATRIX_ROWS=1 -DMATRIX_COLS=1 -DNO_DEBUG -DAUDIO_ENABLE -DAUDIO_INIT_DELAY
+audio_INC := $(QUANTUM_PATH)/audio
+
+audio_SRC := \
+	$(QUANTUM_PATH)/audio/tests/driver_mock.c \
+	$(QUANTUM_PATH)/audio/tests/audio_tests.cpp \
+	$(QUANTUM_PATH)/audio/audio.c \
+	$(QUANTUM_PATH)/audio/voices.c \
+	$(QUANTUM_PATH)/audio/luts.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c
@@ -19,27 +19,15 @@
 #include "progmem.h"
 #include "util.h"
 
+// Index into {v, p, q, t} for each of r, g and b, by hue region. Row 7 is used for greys (zero saturation).
+static const uint8_t hsv_region_channels[8][3] = {
+    {0, 3, 1}, {2, 0, 1}, {1, 0, 3}, {1, 2, 0}, {3, 1, 0}, {0, 1, 2}, {0, 3, 1}, {0, 0, 0},
+};
+
 RGB hsv_to_rgb_impl(HSV hsv, bool use_cie) {
     RGB      rgb;
-    uint8_t  region, remainder, p, q, t;
-    uint16_t h, s, v;
-
-    if (hsv.s == 0) {
-#ifdef USE_CIE1931_CURVE
-        if (use_cie) {
-            rgb.r = rgb.g = rgb.b = pgm_read_byte(&CIE1931_CURVE[hsv.v]);
-        } else {
-            rgb.r = hsv.v;
-            rgb.g = hsv.v;
-            rgb.b = hsv.v;
-        }
-#else
-        rgb.r = hsv.v;
-        rgb.g = hsv.v;
-        rgb.b = hsv.v;
-#endif
-        return rgb;
-    }
+    uint8_t  region, remainder, values[4];
+    uint16_t h, s, v, h6;
 
     h = hsv.h;
     s = hsv.s;
@@ -53,46 +41,21 @@ RGB hsv_to_rgb_impl(HSV hsv, bool use_cie) {
     v = hsv.v;
 #endif
 
-    region    = h * 6 / 255;
+    // h * 6 / 255 without the division
+    h6        = h * 6;
+    region    = (h6 + 1 + (h6 >> 8)) >> 8;
     remainder = (h * 2 - region * 85) * 3;
 
-    p = (v * (255 - s)) >> 8;
-    q = (v * (255 - ((s * remainder) >> 8))) >> 8;
-    t = (v * (255 - ((s * (255 - remainder)) >> 8))) >> 8;
+    values[0] = v;
+    values[1] = (v * (255 - s)) >> 8;
+    values[2] = (v * (255 - ((s * remainder) >> 8))) >> 8;
+    values[3] = (v * (255 - ((s * (255 - remainder)) >> 8))) >> 8;
 
-    switch (region) {
-        case 6:
-        case 0:
-            rgb.r = v;
-            rgb.g = t;
-            rgb.b = p;
-            break;
-        case 1:
-            rgb.r = q;
-            rgb.g = v;
-            rgb.b = p;
-            break;
-        case 2:
-            rgb.r = p;
-            rgb.g = v;
-            rgb.b = t;
-            break;
-        case 3:
-            rgb.r = p;
-            rgb.g = q;
-            rgb.b = v;
-            break;
-        case 4:
-            rgb.r = t;
-            rgb.g = p;
-            rgb.b = v;
-            break;
-        default:
-            rgb.r = v;
-            rgb.g = p;
-            rgb.b = q;
-            break;
-    }
+    const uint8_t *channels = hsv_region_channels[s ? region : 7];
+
+    rgb.r = values[channels[0]];
+    rgb.g = values[channels[1]];
+    rgb.b = values[channels[2]];
 
     return rgb;
 }
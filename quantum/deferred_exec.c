@@ -12,31 +12,124 @@
 //------------------------------------
 // Helpers
 //
+// Executors stay in the table slot they were allocated in, while their trigger order is kept in a binary min-heap of
+// slot numbers threaded through the same table: heap position `p` holds its slot in `table[p].heap_slot`, and slot `s`
+// holds its heap position in `table[s].heap_pos`. Both are stored as offsets from their own index, so a zeroed table is
+// already a valid empty heap. The pending executors occupy the front of the heap, followed by the free slots.
+//
+// Tokens carry the slot in the low byte and a per-slot generation in the high byte, so a stale token never matches a
+// later executor that reuses the same slot.
 
-static deferred_token current_token = 0;
+#define DEFERRED_TOKEN_SLOT(token) ((uint8_t)((token)&0xFF) - 1)
+#define DEFERRED_TOKEN_GENERATION(token) ((uint8_t)((token) >> 8))
+#define DEFERRED_TOKEN_MAKE(generation, slot) ((deferred_token)(((deferred_token)(generation) << 8) | ((slot) + 1)))
 
-static inline bool token_can_be_used(deferred_executor_t *table, size_t table_count, deferred_token token) {
-    if (token == INVALID_DEFERRED_TOKEN) {
-        return false;
-    }
-    for (int i = 0; i < table_count; ++i) {
-        if (table[i].token == token) {
-            return false;
+static inline uint8_t table_size(size_t table_count) {
+    // Slots have to fit in the low byte of a token
+    return table_count < UINT8_MAX ? table_count : UINT8_MAX;
+}
+
+static inline uint8_t heap_slot(deferred_executor_t *table, uint8_t pos) {
+    return pos + table[pos].heap_slot;
+}
+
+static inline uint8_t heap_pos(deferred_executor_t *table, uint8_t slot) {
+    return slot + table[slot].heap_pos;
+}
+
+static inline void heap_set(deferred_executor_t *table, uint8_t pos, uint8_t slot) {
+    table[pos].heap_slot = slot - pos;
+    table[slot].heap_pos = pos - slot;
+}
+
+static inline bool heap_before(deferred_executor_t *table, uint8_t a, uint8_t b) {
+    return ((int32_t)TIMER_DIFF_32(table[heap_slot(table, a)].trigger_time, table[heap_slot(table, b)].trigger_time)) < 0;
+}
+
+static inline void heap_swap(deferred_executor_t *table, uint8_t a, uint8_t b) {
+    uint8_t slot_a = heap_slot(table, a);
+    heap_set(table, a, heap_slot(table, b));
+    heap_set(table, b, slot_a);
+}
+
+static uint8_t heap_count(deferred_executor_t *table, uint8_t table_count) {
+    // Pending executors are contiguous at the front of the heap, binary search for the first free one
+    uint8_t lo = 0, hi = table_count;
+    while (lo < hi) {
+        uint8_t mid = lo + (hi - lo) / 2;
+        if (table[heap_slot(table, mid)].callback) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
         }
     }
-    return true;
+    return lo;
 }
 
-static inline deferred_token allocate_token(deferred_executor_t *table, size_t table_count) {
-    deferred_token first = ++current_token;
-    while (!token_can_be_used(table, table_count, current_token)) {
-        ++current_token;
-        if (current_token == first) {
-            // If we've looped back around to the first, everything is already allocated (yikes!). Need to exit with a failure.
-            return INVALID_DEFERRED_TOKEN;
+static void heap_sift(deferred_executor_t *table, uint8_t pos, uint8_t count) {
+    while (pos > 0) {
+        uint8_t parent = (pos - 1) / 2;
+        if (!heap_before(table, pos, parent)) {
+            break;
+        }
+        heap_swap(table, pos, parent);
+        pos = parent;
+    }
+    while (true) {
+        uint16_t child = 2 * (uint16_t)pos + 1;
+        if (child >= count) {
+            break;
+        }
+        if (child + 1 < count && heap_before(table, child + 1, child)) {
+            ++child;
+        }
+        if (!heap_before(table, child, pos)) {
+            break;
         }
+        heap_swap(table, pos, child);
+        pos = child;
+    }
+}
+
+static void heap_remove(deferred_executor_t *table, uint8_t pos, uint8_t count) {
+    // Move the executor to the end of the pending range, free it, then restore the order of whatever took its place
+    uint8_t last = count - 1;
+    heap_swap(table, pos, last);
+
+    deferred_executor_t *entry = &table[heap_slot(table, last)];
+    entry->trigger_time        = 0;
+    entry->callback            = NULL;
+    entry->cb_arg              = NULL;
+
+    if (pos < last) {
+        heap_sift(table, pos, last);
+    }
+}
+
+static void heap_collect_due(deferred_executor_t *table, uint8_t pos, uint8_t count, uint32_t now, uint8_t *due) {
+    // Due executors form a subtree at the root of the heap, so only that subtree needs visiting
+    if (pos >= count) {
+        return;
+    }
+    uint8_t slot = heap_slot(table, pos);
+    if (((int32_t)TIMER_DIFF_32(table[slot].trigger_time, now)) > 0) {
+        return;
+    }
+    due[slot / 8] |= 1 << (slot % 8);
+    heap_collect_due(table, 2 * (uint16_t)pos + 1, count, now, due);
+    heap_collect_due(table, 2 * (uint16_t)pos + 2, count, now, due);
+}
+
+static deferred_executor_t *find_executor(deferred_executor_t *table, uint8_t table_count, deferred_token token) {
+    uint8_t slot = DEFERRED_TOKEN_SLOT(token);
+    if (token == INVALID_DEFERRED_TOKEN || slot >= table_count) {
+        return NULL;
+    }
+    deferred_executor_t *entry = &table[slot];
+    if (entry->token != token || !entry->callback) {
+        return NULL;
     }
-    return current_token;
+    return entry;
 }
 
 //------------------------------------
@@ -49,27 +142,23 @@ deferred_token defer_exec_advanced(deferred_executor_t *table, size_t table_coun
         return INVALID_DEFERRED_TOKEN;
     }
 
-    // Find an unused slot and claim it
-    for (int i = 0; i < table_count; ++i) {
-        deferred_executor_t *entry = &table[i];
-        if (entry->token == INVALID_DEFERRED_TOKEN) {
-            // Work out the new token value, dropping out if none were available
-            deferred_token token = allocate_token(table, table_count);
-            if (token == INVALID_DEFERRED_TOKEN) {
-                return false;
-            }
-
-            // Set up the executor table entry
-            entry->token        = current_token;
-            entry->trigger_time = timer_read32() + delay_ms;
-            entry->callback     = callback;
-            entry->cb_arg       = cb_arg;
-            return current_token;
-        }
+    // The first free slot follows the pending executors in the heap
+    uint8_t size  = table_size(table_count);
+    uint8_t count = heap_count(table, size);
+    if (count == size) {
+        // None available
+        return INVALID_DEFERRED_TOKEN;
     }
 
-    // None available
-    return INVALID_DEFERRED_TOKEN;
+    // Set up the executor table entry, bumping the slot's generation to invalidate any older token
+    uint8_t              slot  = heap_slot(table, count);
+    deferred_executor_t *entry = &table[slot];
+    entry->token               = DEFERRED_TOKEN_MAKE(DEFERRED_TOKEN_GENERATION(entry->token) + 1, slot);
+    entry->trigger_time        = timer_read32() + delay_ms;
+    entry->callback            = callback;
+    entry->cb_arg              = cb_arg;
+    heap_sift(table, count, count + 1);
+    return entry->token;
 }
 
 bool extend_deferred_exec_advanced(deferred_executor_t *table, size_t table_count, deferred_token token, uint32_t delay_ms) {
@@ -79,17 +168,17 @@ bool extend_deferred_exec_advanced(deferred_executor_t *table, size_t table_coun
     }
 
     // Find the entry corresponding to the token
-    for (int i = 0; i < table_count; ++i) {
-        deferred_executor_t *entry = &table[i];
-        if (entry->token == token) {
-            // Found it, extend the delay
-            entry->trigger_time = timer_read32() + delay_ms;
-            return true;
-        }
+    uint8_t              size  = table_size(table_count);
+    deferred_executor_t *entry = find_executor(table, size, token);
+    if (!entry) {
+        // Not found
+        return false;
     }
 
-    // Not found
-    return false;
+    // Found it, extend the delay
+    entry->trigger_time = timer_read32() + delay_ms;
+    heap_sift(table, heap_pos(table, DEFERRED_TOKEN_SLOT(token)), heap_count(table, size));
+    return true;
 }
 
 bool cancel_deferred_exec_advanced(deferred_executor_t *table, size_t table_count, deferred_token token) {
@@ -99,20 +188,15 @@ bool cancel_deferred_exec_advanced(deferred_executor_t *table, size_t table_coun
     }
 
     // Find the entry corresponding to the token
-    for (int i = 0; i < table_count; ++i) {
-        deferred_executor_t *entry = &table[i];
-        if (entry->token == token) {
-            // Found it, cancel and clear the table entry
-            entry->token        = INVALID_DEFERRED_TOKEN;
-            entry->trigger_time = 0;
-            entry->callback     = NULL;
-            entry->cb_arg       = NULL;
-            return true;
-        }
+    uint8_t size = table_size(table_count);
+    if (!find_executor(table, size, token)) {
+        // Not found
+        return false;
     }
 
-    // Not found
-    return false;
+    // Found it, cancel and clear the table entry
+    heap_remove(table, heap_pos(table, DEFERRED_TOKEN_SLOT(token)), heap_count(table, size));
+    return true;
 }
 
 void deferred_exec_advanced_task(deferred_executor_t *table, size_t table_count, uint32_t *last_execution_time) {
@@ -122,29 +206,49 @@ void deferred_exec_advanced_task(deferred_executor_t *table, size_t table_count,
     if (((int32_t)TIMER_DIFF_32(now, (*last_execution_time))) > 0) {
         *last_execution_time = now;
 
-        // Run through each of the executors
-        for (int i = 0; i < table_count; ++i) {
+        // Nothing to do unless the earliest executor is due
+        uint8_t size  = table_size(table_count);
+        uint8_t count = heap_count(table, size);
+        if (count == 0 || ((int32_t)TIMER_DIFF_32(table[heap_slot(table, 0)].trigger_time, now)) > 0) {
+            return;
+        }
+
+        // Work out which executors are due up front, so that each is invoked at most once even if it's requeued with a
+        // trigger time that has already passed
+        uint8_t due[(UINT8_MAX + 7) / 8] = {0};
+        heap_collect_due(table, 0, count, now, due);
+
+        for (uint8_t i = 0; i < size; ++i) {
+            if (!(due[i / 8] & (1 << (i % 8)))) {
+                continue;
+            }
+
+            // Earlier callbacks may have cancelled or extended this one
             deferred_executor_t *entry = &table[i];
+            if (!entry->callback || ((int32_t)TIMER_DIFF_32(entry->trigger_time, now)) > 0) {
+                continue;
+            }
+
+            // Invoke the callback and work work out if we should be requeued
+            deferred_token token    = entry->token;
+            uint32_t       delay_ms = entry->callback(entry->trigger_time, entry->cb_arg);
+
+            // The callback may have cancelled itself
+            if (entry->token != token || !entry->callback) {
+                continue;
+            }
 
-            // Check if we're supposed to execute this entry
-            if (entry->token != INVALID_DEFERRED_TOKEN && ((int32_t)TIMER_DIFF_32(entry->trigger_time, now)) <= 0) {
-                // Invoke the callback and work work out if we should be requeued
-                uint32_t delay_ms = entry->callback(entry->trigger_time, entry->cb_arg);
-
-                // Update the trigger time if we have to repeat, otherwise clear it out
-                if (delay_ms > 0) {
-                    // Intentionally add just the delay to the existing trigger time -- this ensures the next
-                    // invocation is with respect to the previous trigger, rather than when it got to execution. Under
-                    // normal circumstances this won't cause issue, but if another executor is invoked that takes a
-                    // considerable length of time, then this ensures best-effort timing between invocations.
-                    entry->trigger_time += delay_ms;
-                } else {
-                    // If it was zero, then the callback is cancelling repeated execution. Free up the slot.
-                    entry->token        = INVALID_DEFERRED_TOKEN;
-                    entry->trigger_time = 0;
-                    entry->callback     = NULL;
-                    entry->cb_arg       = NULL;
-                }
+            // Update the trigger time if we have to repeat, otherwise clear it out
+            if (delay_ms > 0) {
+                // Intentionally add just the delay to the existing trigger time -- this ensures the next
+                // invocation is with respect to the previous trigger, rather than when it got to execution. Under
+                // normal circumstances this won't cause issue, but if another executor is invoked that takes a
+                // considerable length of time, then this ensures best-effort timing between invocations.
+                entry->trigger_time += delay_ms;
+                heap_sift(table, heap_pos(table, i), heap_count(table, size));
+            } else {
+                // If it was zero, then the callback is cancelling repeated execution. Free up the slot.
+                heap_remove(table, heap_pos(table, i), heap_count(table, size));
             }
         }
     }
@@ -14,7 +14,7 @@
 /**
  * @typedef A token that can be used to cancel or extend an existing deferred execution.
  */
-typedef uint8_t deferred_token;
+typedef uint16_t deferred_token;
 
 /**
  * @def The constant used to denote an invalid deferred execution token.
@@ -79,13 +79,15 @@ typedef struct deferred_executor_t {
     uint32_t               trigger_time;
     deferred_exec_callback callback;
     void *                 cb_arg;
+    uint8_t                heap_slot;
+    uint8_t                heap_pos;
 } deferred_executor_t;
 
 /**
  * Configures the supplied deferred executor to be executed after the required number of milliseconds.
  *
- * @param table[in] the custom table used for storage
- * @param table_count[in] the number of available items in the table
+ * @param table[in] the custom table used for storage, which must be zero-initialised
+ * @param table_count[in] the number of available items in the table, at most 255 are used
  * @param delay_ms[in] the number of milliseconds before executing the callback
  * @param callback[in] the executor to invoke
  * @param cb_arg[in] the argument to pass to the executor, may be NULL if unused by the executor
@@ -14,11 +14,13 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <string.h>
 #include "keymap_introspection.h" // to get keymaps[][][]
 #include "eeprom.h"
 #include "progmem.h" // to read default from flash
 #include "quantum.h" // for send_string()
 #include "dynamic_keymap.h"
+#include "util.h"
 
 #ifdef VIA_ENABLE
 #    include "via.h" // for VIA_EEPROM_CONFIG_END
@@ -176,28 +178,21 @@ void dynamic_keymap_reset(void) {
 void dynamic_keymap_get_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
     uint16_t dynamic_keymap_eeprom_size = DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2;
     void *   source                     = (void *)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset);
-    uint8_t *target                     = data;
-    for (uint16_t i = 0; i < size; i++) {
-        if (offset + i < dynamic_keymap_eeprom_size) {
-            *target = eeprom_read_byte(source);
-        } else {
-            *target = 0x00;
-        }
-        source++;
-        target++;
+    uint16_t valid_size                 = 0;
+    if (offset < dynamic_keymap_eeprom_size) {
+        valid_size = MIN(size, dynamic_keymap_eeprom_size - offset);
+        // Read the whole range in one go, so drivers can use a single sequential read
+        eeprom_read_block(data, source, valid_size);
     }
+    memset(data + valid_size, 0x00, size - valid_size);
 }
 
 void dynamic_keymap_set_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
     uint16_t dynamic_keymap_eeprom_size = DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2;
     void *   target                     = (void *)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset);
-    uint8_t *source                     = data;
-    for (uint16_t i = 0; i < size; i++) {
-        if (offset + i < dynamic_keymap_eeprom_size) {
-            eeprom_update_byte(target, *source);
-        }
-        source++;
-        target++;
+    if (offset < dynamic_keymap_eeprom_size) {
+        // Update the whole range in one go, so drivers can merge the changes into page writes
+        eeprom_update_block(data, target, MIN(size, dynamic_keymap_eeprom_size - offset));
     }
 }
 
@@ -226,28 +221,19 @@ uint16_t dynamic_keymap_macro_get_buffer_size(void) {
 }
 
 void dynamic_keymap_macro_get_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
-    void *   source = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset);
-    uint8_t *target = data;
-    for (uint16_t i = 0; i < size; i++) {
-        if (offset + i < DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE) {
-            *target = eeprom_read_byte(source);
-        } else {
-            *target = 0x00;
-        }
-        source++;
-        target++;
+    void *   source     = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset);
+    uint16_t valid_size = 0;
+    if (offset < DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE) {
+        valid_size = MIN(size, DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE - offset);
+        eeprom_read_block(data, source, valid_size);
     }
+    memset(data + valid_size, 0x00, size - valid_size);
 }
 
 void dynamic_keymap_macro_set_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
-    void *   target = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset);
-    uint8_t *source = data;
-    for (uint16_t i = 0; i < size; i++) {
-        if (offset + i < DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE) {
-            eeprom_update_byte(target, *source);
-        }
-        source++;
-        target++;
+    void *target = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset);
+    if (offset < DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE) {
+        eeprom_update_block(data, target, MIN(size, DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE - offset));
     }
 }
 
@@ -23,6 +23,15 @@
 // for memcpy
 #include <string.h>
 
+#ifdef ENCODER_INTERRUPTS
+#    if !defined(PROTOCOL_CHIBIOS)
+#        error "ENCODER_INTERRUPTS is only supported on ChibiOS"
+#    elif !PAL_USE_CALLBACKS
+#        error "ENCODER_INTERRUPTS requires PAL_USE_CALLBACKS to be enabled in halconf.h"
+#    endif
+#    include "atomic_util.h"
+#endif
+
 #ifndef ENCODER_MAP_KEY_DELAY
 #    include "action.h"
 #    define ENCODER_MAP_KEY_DELAY TAP_CODE_DELAY
@@ -57,6 +66,23 @@ static int8_t encoder_LUT[] = {0, -1, 1, 0, 1, 0, 0, -1, -1, 0, 0, 1, 0, 1, -1,
 static uint8_t encoder_state[NUM_ENCODERS]  = {0};
 static int8_t  encoder_pulses[NUM_ENCODERS] = {0};
 
+// Whole detents counted since the last encoder_read(), positive is counter-clockwise
+static volatile int8_t encoder_steps[NUM_ENCODERS] = {0};
+
+#ifdef ENCODER_MAP_ENABLE
+// Map taps still to be sent per encoder, positive is clockwise. Opposite turns cancel each other out.
+static int8_t encoder_map_pending[NUM_ENCODERS] = {0};
+#    if ENCODER_MAP_KEY_DELAY > 0
+// Direction of the map key currently held down per encoder, zero when released
+static int8_t   encoder_map_held[NUM_ENCODERS]  = {0};
+static uint16_t encoder_map_timer[NUM_ENCODERS] = {0};
+#    endif // ENCODER_MAP_KEY_DELAY > 0
+#endif // ENCODER_MAP_ENABLE
+
+#ifdef ENCODER_INTERRUPTS
+static void encoder_pad_callback(void *arg);
+#endif
+
 // encoder counts
 static uint8_t thisCount;
 #ifdef SPLIT_KEYBOARD
@@ -124,6 +150,13 @@ void encoder_init(void) {
     memset(encoder_value, 0, sizeof(encoder_value));
     memset(encoder_state, 0, sizeof(encoder_state));
     memset(encoder_pulses, 0, sizeof(encoder_pulses));
+    memset((void *)encoder_steps, 0, sizeof(encoder_steps));
+#    ifdef ENCODER_MAP_ENABLE
+    memset(encoder_map_pending, 0, sizeof(encoder_map_pending));
+#        if ENCODER_MAP_KEY_DELAY > 0
+    memset(encoder_map_held, 0, sizeof(encoder_map_held));
+#        endif
+#    endif
     static const pin_t encoders_pad_a_left[] = ENCODERS_PAD_A;
     static const pin_t encoders_pad_b_left[] = ENCODERS_PAD_B;
     for (uint8_t i = 0; i < thisCount; i++) {
@@ -164,91 +197,179 @@ void encoder_init(void) {
     for (uint8_t i = 0; i < thisCount; i++) {
         encoder_state[i] = (readPin(encoders_pad_a[i]) << 0) | (readPin(encoders_pad_b[i]) << 1);
     }
+
+#ifdef ENCODER_INTERRUPTS
+    for (uint8_t i = 0; i < thisCount; i++) {
+        palEnableLineEvent(encoders_pad_a[i], PAL_EVENT_MODE_BOTH_EDGES);
+        palSetLineCallback(encoders_pad_a[i], encoder_pad_callback, (void *)(uintptr_t)i);
+        palEnableLineEvent(encoders_pad_b[i], PAL_EVENT_MODE_BOTH_EDGES);
+        palSetLineCallback(encoders_pad_b[i], encoder_pad_callback, (void *)(uintptr_t)i);
+    }
+#endif
 }
 
 #ifdef ENCODER_MAP_ENABLE
 static void encoder_exec_mapping(uint8_t index, bool clockwise) {
-    // The delays below cater for Windows and its wonderful requirements.
-    action_exec(clockwise ? MAKE_ENCODER_CW_EVENT(index, true) : MAKE_ENCODER_CCW_EVENT(index, true));
-#    if ENCODER_MAP_KEY_DELAY > 0
-    wait_ms(ENCODER_MAP_KEY_DELAY);
-#    endif // ENCODER_MAP_KEY_DELAY > 0
+    // Only queue the tap here, encoder_map_task() sends it without stalling the scan loop
+    if (clockwise ? encoder_map_pending[index] < INT8_MAX : encoder_map_pending[index] > INT8_MIN) {
+        encoder_map_pending[index] += clockwise ? 1 : -1;
+    }
+}
+
+static void encoder_map_event(uint8_t index, bool clockwise, bool pressed) {
+    action_exec(clockwise ? MAKE_ENCODER_CW_EVENT(index, pressed) : MAKE_ENCODER_CCW_EVENT(index, pressed));
+}
 
-    action_exec(clockwise ? MAKE_ENCODER_CW_EVENT(index, false) : MAKE_ENCODER_CCW_EVENT(index, false));
+static void encoder_map_task(void) {
+    for (uint8_t index = 0; index < NUM_ENCODERS; index++) {
 #    if ENCODER_MAP_KEY_DELAY > 0
-    wait_ms(ENCODER_MAP_KEY_DELAY);
+        // The delays cater for Windows and its wonderful requirements, so each press and release
+        // is sent on a later pass once ENCODER_MAP_KEY_DELAY has elapsed since the previous one.
+        if (encoder_map_held[index] == 0 && encoder_map_pending[index] == 0) {
+            continue;
+        }
+        if (timer_elapsed(encoder_map_timer[index]) < ENCODER_MAP_KEY_DELAY) {
+            continue;
+        }
+        if (encoder_map_held[index] != 0) {
+            encoder_map_event(index, encoder_map_held[index] > 0, false);
+            encoder_map_held[index] = 0;
+        } else {
+            const bool clockwise = encoder_map_pending[index] > 0;
+            encoder_map_pending[index] -= clockwise ? 1 : -1;
+            encoder_map_held[index] = clockwise ? 1 : -1;
+            encoder_map_event(index, clockwise, true);
+        }
+        encoder_map_timer[index] = timer_read();
+#    else  // ENCODER_MAP_KEY_DELAY > 0
+        while (encoder_map_pending[index] != 0) {
+            const bool clockwise = encoder_map_pending[index] > 0;
+            encoder_map_pending[index] -= clockwise ? 1 : -1;
+            encoder_map_event(index, clockwise, true);
+            encoder_map_event(index, clockwise, false);
+        }
 #    endif // ENCODER_MAP_KEY_DELAY > 0
+    }
 }
 #endif // ENCODER_MAP_ENABLE
 
-static bool encoder_update(uint8_t index, uint8_t state) {
-    bool    changed = false;
-    uint8_t i       = index;
-
-#ifdef ENCODER_RESOLUTIONS
-    const uint8_t resolution = encoder_resolutions[i];
-#else
-    const uint8_t resolution = ENCODER_RESOLUTION;
-#endif
+static bool encoder_update(uint8_t i, int8_t steps) {
+    bool    changed = steps != 0;
+    uint8_t index   = i;
 
 #ifdef SPLIT_KEYBOARD
     index += thisHand;
 #endif
-    encoder_pulses[i] += encoder_LUT[state & 0xF];
-
-#ifdef ENCODER_DEFAULT_POS
-    if ((encoder_pulses[i] >= resolution) || (encoder_pulses[i] <= -resolution) || ((state & 0x3) == ENCODER_DEFAULT_POS)) {
-        if (encoder_pulses[i] >= 1) {
-#else
-    if (encoder_pulses[i] >= resolution) {
-#endif
-
-            encoder_value[index]++;
-            changed = true;
+    for (; steps > 0; steps--) {
+        encoder_value[index]++;
 #ifdef SPLIT_KEYBOARD
-            if (should_process_encoder())
+        if (should_process_encoder())
 #endif // SPLIT_KEYBOARD
 #ifdef ENCODER_MAP_ENABLE
-                encoder_exec_mapping(index, ENCODER_COUNTER_CLOCKWISE);
+            encoder_exec_mapping(index, ENCODER_COUNTER_CLOCKWISE);
 #else  // ENCODER_MAP_ENABLE
         encoder_update_kb(index, ENCODER_COUNTER_CLOCKWISE);
 #endif // ENCODER_MAP_ENABLE
-        }
-
-#ifdef ENCODER_DEFAULT_POS
-        if (encoder_pulses[i] <= -1) {
-#else
-    if (encoder_pulses[i] <= -resolution) { // direction is arbitrary here, but this clockwise
-#endif
-            encoder_value[index]--;
-            changed = true;
+    }
+    for (; steps < 0; steps++) { // direction is arbitrary here, but this clockwise
+        encoder_value[index]--;
 #ifdef SPLIT_KEYBOARD
-            if (should_process_encoder())
+        if (should_process_encoder())
 #endif // SPLIT_KEYBOARD
 #ifdef ENCODER_MAP_ENABLE
-                encoder_exec_mapping(index, ENCODER_CLOCKWISE);
+            encoder_exec_mapping(index, ENCODER_CLOCKWISE);
 #else  // ENCODER_MAP_ENABLE
         encoder_update_kb(index, ENCODER_CLOCKWISE);
 #endif // ENCODER_MAP_ENABLE
-        }
-        encoder_pulses[i] %= resolution;
+    }
+    return changed;
+}
+
+static void encoder_add_step(uint8_t i, int8_t step) {
+    // Saturate rather than wrap if encoder_read() falls far behind
+    if ((step > 0 && encoder_steps[i] < INT8_MAX) || (step < 0 && encoder_steps[i] > INT8_MIN)) {
+        encoder_steps[i] += step;
+    }
+}
+
+static void encoder_handle_state_change(uint8_t i, uint8_t state) {
+#ifdef ENCODER_RESOLUTIONS
+    const uint8_t resolution = encoder_resolutions[i];
+#else
+    const uint8_t resolution = ENCODER_RESOLUTION;
+#endif
+
+    encoder_pulses[i] += encoder_LUT[state & 0xF];
+
 #ifdef ENCODER_DEFAULT_POS
+    if ((encoder_pulses[i] >= resolution) || (encoder_pulses[i] <= -resolution) || ((state & 0x3) == ENCODER_DEFAULT_POS)) {
+        if (encoder_pulses[i] >= 1) {
+            encoder_add_step(i, 1);
+        }
+        if (encoder_pulses[i] <= -1) {
+            encoder_add_step(i, -1);
+        }
         encoder_pulses[i] = 0;
     }
+#else
+    if (encoder_pulses[i] >= resolution) {
+        encoder_add_step(i, 1);
+    }
+    if (encoder_pulses[i] <= -resolution) {
+        encoder_add_step(i, -1);
+    }
+    encoder_pulses[i] %= resolution;
 #endif
-    return changed;
+}
+
+static void encoder_handle_read(uint8_t i, uint8_t pin_a_state, uint8_t pin_b_state) {
+    uint8_t new_status = (pin_a_state << 0) | (pin_b_state << 1);
+    if ((encoder_state[i] & 0x3) != new_status) {
+        encoder_state[i] <<= 2;
+        encoder_state[i] |= new_status;
+        encoder_handle_state_change(i, encoder_state[i]);
+    }
+}
+
+#ifdef ENCODER_INTERRUPTS
+static void encoder_pad_callback(void *arg) {
+    uint8_t i = (uintptr_t)arg;
+    chSysLockFromISR();
+    encoder_handle_read(i, readPin(encoders_pad_a[i]), readPin(encoders_pad_b[i]));
+    chSysUnlockFromISR();
+}
+#endif // ENCODER_INTERRUPTS
+
+static int8_t encoder_take_steps(uint8_t i) {
+    int8_t steps;
+#ifdef ENCODER_INTERRUPTS
+    ATOMIC_BLOCK_FORCEON {
+#endif
+        steps            = encoder_steps[i];
+        encoder_steps[i] = 0;
+#ifdef ENCODER_INTERRUPTS
+    }
+#endif
+    return steps;
 }
 
 bool encoder_read(void) {
+#ifndef ENCODER_INTERRUPTS
+    // Without interrupts the pads are sampled here, otherwise the steps have already been counted
+    for (uint8_t i = 0; i < thisCount; i++) {
+        encoder_handle_read(i, readPin(encoders_pad_a[i]), readPin(encoders_pad_b[i]));
+    }
+#endif
+
     bool changed = false;
     for (uint8_t i = 0; i < thisCount; i++) {
-        uint8_t new_status = (readPin(encoders_pad_a[i]) << 0) | (readPin(encoders_pad_b[i]) << 1);
-        if ((encoder_state[i] & 0x3) != new_status) {
-            encoder_state[i] <<= 2;
-            encoder_state[i] |= new_status;
-            changed |= encoder_update(i, encoder_state[i]);
-        }
+        changed |= encoder_update(i, encoder_take_steps(i));
     }
+
+#ifdef ENCODER_MAP_ENABLE
+    // Also drains taps queued by encoder_update_raw() for the other half
+    encoder_map_task();
+#endif
     return changed;
 }
 
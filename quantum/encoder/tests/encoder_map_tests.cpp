@@ -0,0 +1,98 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+#include <vector>
+
+extern "C" {
+#include "keyboard.h"
+#include "timer.h"
+#include "encoder/tests/mock.h"
+
+// encoder.h declares encoder_map with ARRAY_SIZE, which only works in C
+void encoder_init(void);
+bool encoder_read(void);
+void advance_time(uint32_t ms);
+}
+
+struct map_event {
+    uint8_t index;
+    bool    clockwise;
+    bool    pressed;
+
+    bool operator==(const map_event &other) const {
+        return index == other.index && clockwise == other.clockwise && pressed == other.pressed;
+    }
+};
+
+static std::vector<map_event> events;
+
+extern "C" void action_exec(keyevent_t event) {
+    events.push_back({event.key.col, event.type == ENCODER_CW_EVENT, event.pressed});
+}
+
+static void step(bool clockwise) {
+    const pin_t first  = clockwise ? 0 : 1;
+    const pin_t second = clockwise ? 1 : 0;
+    setPin(first, false);
+    encoder_read();
+    setPin(second, false);
+    encoder_read();
+    setPin(first, true);
+    encoder_read();
+    setPin(second, true);
+    encoder_read();
+}
+
+static void run_for(uint32_t ms) {
+    for (uint32_t i = 0; i < ms; i++) {
+        advance_time(1);
+        encoder_read();
+    }
+}
+
+class EncoderMapTest : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        // Let any release left over from the previous test go out first
+        run_for(ENCODER_MAP_KEY_DELAY * 2);
+        encoder_init();
+        events.clear();
+    }
+};
+
+TEST_F(EncoderMapTest, TapIsReleasedOnALaterPass) {
+    step(true);
+    EXPECT_EQ(events, std::vector<map_event>({{0, true, true}}));
+
+    run_for(ENCODER_MAP_KEY_DELAY - 1);
+    EXPECT_EQ(events.size(), 1);
+    run_for(1);
+    EXPECT_EQ(events, std::vector<map_event>({{0, true, true}, {0, true, false}}));
+}
+
+TEST_F(EncoderMapTest, ReadDoesNotBlock) {
+    const uint32_t start = timer_read32();
+    step(true);
+    step(true);
+    step(true);
+    EXPECT_EQ(timer_read32(), start);
+    EXPECT_EQ(events.size(), 1);
+
+    // Each tap is a press and a release, each spaced by the delay
+    run_for(ENCODER_MAP_KEY_DELAY * 5);
+    EXPECT_EQ(events, std::vector<map_event>({{0, true, true}, {0, true, false}, {0, true, true}, {0, true, false}, {0, true, true}, {0, true, false}}));
+}
+
+TEST_F(EncoderMapTest, OppositeTurnsCancelOut) {
+    step(true);
+    step(true);
+    step(false);
+
+    run_for(ENCODER_MAP_KEY_DELAY * 4);
+    EXPECT_EQ(events, std::vector<map_event>({{0, true, true}, {0, true, false}}));
+
+    step(false);
+    run_for(ENCODER_MAP_KEY_DELAY * 2);
+    EXPECT_EQ(events, std::vector<map_event>({{0, true, true}, {0, true, false}, {0, false, true}, {0, false, false}}));
+}
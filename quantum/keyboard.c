@@ -456,13 +456,16 @@ void switch_events(uint8_t row, uint8_t col, bool pressed) {
 
 /**
  * @brief Generates a tick event at a maximum rate of 1KHz that drives the
- * internal QMK state machine.
+ * internal QMK state machine. Ticks are only generated while the state
+ * machine has a timeout pending, an idle keyboard skips them entirely.
  */
 static inline void generate_tick_event(void) {
     static uint16_t last_tick = 0;
     const uint16_t  now       = timer_read();
     if (TIMER_DIFF_16(now, last_tick) != 0) {
-        action_exec(MAKE_TICK_EVENT);
+        if (action_tick_pending()) {
+            action_exec(MAKE_TICK_EVENT);
+        }
         last_tick = now;
     }
 }
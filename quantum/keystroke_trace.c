@@ -0,0 +1,90 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+#include "keystroke_trace.h"
+#include "print.h"
+#include "raw_hid.h"
+
+_Static_assert((KEYSTROKE_TRACE_SIZE & (KEYSTROKE_TRACE_SIZE - 1)) == 0, "KEYSTROKE_TRACE_SIZE must be a power of two");
+_Static_assert(MATRIX_COLS <= KEYSTROKE_TRACE_COL_MASK + 1, "Keystroke trace records can't hold more than 128 columns");
+
+static keystroke_trace_record_t trace[KEYSTROKE_TRACE_SIZE];
+static uint16_t                 trace_head  = 0;
+static uint16_t                 trace_count = 0;
+
+void keystroke_trace_record(keyevent_t event) {
+    keystroke_trace_record_t *record = &trace[trace_head];
+
+    record->time = event.time;
+    record->row  = event.key.row;
+    record->col  = event.key.col | (event.pressed ? KEYSTROKE_TRACE_PRESSED : 0);
+
+    trace_head = (trace_head + 1) & (KEYSTROKE_TRACE_SIZE - 1);
+    if (trace_count < KEYSTROKE_TRACE_SIZE) {
+        trace_count++;
+    }
+}
+
+uint16_t keystroke_trace_count(void) {
+    return trace_count;
+}
+
+uint16_t keystroke_trace_read(uint16_t offset, keystroke_trace_record_t *records, uint16_t count) {
+    if (offset >= trace_count) {
+        return 0;
+    }
+    if (count > trace_count - offset) {
+        count = trace_count - offset;
+    }
+
+    uint16_t oldest = (trace_head - trace_count) & (KEYSTROKE_TRACE_SIZE - 1);
+    for (uint16_t i = 0; i < count; i++) {
+        records[i] = trace[(oldest + offset + i) & (KEYSTROKE_TRACE_SIZE - 1)];
+    }
+    return count;
+}
+
+void keystroke_trace_clear(void) {
+    trace_head  = 0;
+    trace_count = 0;
+}
+
+void keystroke_trace_print(void) {
+    keystroke_trace_record_t record;
+
+    uprintf("keystroke trace: %u records\n", trace_count);
+    for (uint16_t i = 0; keystroke_trace_read(i, &record, 1); i++) {
+        uprintf("%02X%02X%02X%02X%s", record.time & 0xFF, record.time >> 8, record.row, record.col, (i % 8 == 7 || i + 1 == trace_count) ? "\n" : " ");
+    }
+}
+
+/* Request: [KEYSTROKE_TRACE_RAW_HID_ID, command, offset (LE16)]
+ * Reply:   [KEYSTROKE_TRACE_RAW_HID_ID, command, total records (LE16), records in packet, records...]
+ */
+bool keystroke_trace_raw_hid_receive(uint8_t *data, uint8_t length) {
+    if (length < 5 || data[0] != KEYSTROKE_TRACE_RAW_HID_ID) {
+        return false;
+    }
+
+    uint16_t offset = data[2] | (data[3] << 8);
+    uint8_t  count  = 0;
+    switch (data[1]) {
+        case KEYSTROKE_TRACE_READ:
+            count = keystroke_trace_read(offset, (keystroke_trace_record_t *)&data[5], (length - 5) / sizeof(keystroke_trace_record_t));
+            memset(&data[5 + count * sizeof(keystroke_trace_record_t)], 0, length - 5 - count * sizeof(keystroke_trace_record_t));
+            break;
+        case KEYSTROKE_TRACE_CLEAR:
+            keystroke_trace_clear();
+            memset(&data[5], 0, length - 5);
+            break;
+        default:
+            return false;
+    }
+
+    data[2] = trace_count & 0xFF;
+    data[3] = trace_count >> 8;
+    data[4] = count;
+    raw_hid_send(data, length);
+    return true;
+}
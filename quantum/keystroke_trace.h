@@ -0,0 +1,87 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "keyboard.h"
+
+#ifndef KEYSTROKE_TRACE_SIZE
+#    define KEYSTROKE_TRACE_SIZE 64
+#endif
+
+#ifndef KEYSTROKE_TRACE_RAW_HID_ID
+#    define KEYSTROKE_TRACE_RAW_HID_ID 0x4B
+#endif
+
+#define KEYSTROKE_TRACE_PRESSED 0x80
+#define KEYSTROKE_TRACE_COL_MASK 0x7F
+
+/**
+ * \brief A recorded key event, 4 bytes on the wire: time (little endian), row,
+ * column with KEYSTROKE_TRACE_PRESSED set for presses.
+ *
+ * Encoder events are recorded with their KEYLOC_ENCODER_CW/CCW row and the
+ * encoder index as the column.
+ */
+typedef struct __attribute__((packed)) {
+    uint16_t time;
+    uint8_t  row;
+    uint8_t  col;
+} keystroke_trace_record_t;
+
+enum keystroke_trace_raw_hid_command {
+    KEYSTROKE_TRACE_READ  = 0x00,
+    KEYSTROKE_TRACE_CLEAR = 0x01,
+};
+
+/**
+ * \brief Records an event into the trace ring buffer, overwriting the oldest
+ * record when it is full. Called by action_exec() for every non-tick event.
+ */
+void keystroke_trace_record(keyevent_t event);
+
+/**
+ * \brief Number of records currently held, at most KEYSTROKE_TRACE_SIZE.
+ */
+uint16_t keystroke_trace_count(void);
+
+/**
+ * \brief Copies up to `count` records, oldest first, starting `offset` records
+ * after the oldest one. Returns the number of records copied.
+ */
+uint16_t keystroke_trace_read(uint16_t offset, keystroke_trace_record_t *records, uint16_t count);
+
+void keystroke_trace_clear(void);
+
+/**
+ * \brief Dumps the trace to the console, as lines of hex encoded records.
+ */
+void keystroke_trace_print(void);
+
+/**
+ * \brief Handles a keystroke trace raw HID request, to be called from
+ * raw_hid_receive() or raw_hid_receive_kb(). Returns false if the packet is
+ * not a keystroke trace request, otherwise the reply has been sent.
+ */
+bool keystroke_trace_raw_hid_receive(uint8_t *data, uint8_t length);
+
+/**
+ * \brief Reconstructs the event a record was made from.
+ */
+static inline keyevent_t keystroke_trace_event(keystroke_trace_record_t record) {
+    keyevent_type_t type = KEY_EVENT;
+    if (record.row == KEYLOC_ENCODER_CW) {
+        type = ENCODER_CW_EVENT;
+    } else if (record.row == KEYLOC_ENCODER_CCW) {
+        type = ENCODER_CCW_EVENT;
+    }
+    keyevent_t event;
+    event.key.row = record.row;
+    event.key.col = record.col & KEYSTROKE_TRACE_COL_MASK;
+    event.time    = record.time;
+    event.type    = type;
+    event.pressed = record.col & KEYSTROKE_TRACE_PRESSED;
+    return event;
+}
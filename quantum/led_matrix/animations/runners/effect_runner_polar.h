@@ -0,0 +1,15 @@
+#pragma once
+
+typedef uint8_t (*polar_f)(uint8_t val, uint8_t angle, uint8_t dist, uint8_t time);
+
+LED_RENDER_RUNNER bool effect_runner_polar(effect_params_t* params, polar_f effect_func) {
+    LED_MATRIX_USE_LIMITS(led_min, led_max);
+
+    uint8_t time = scale16by8(g_led_timer, led_matrix_eeconfig.speed / 2);
+    for (uint8_t i = led_min; i < led_max; i++) {
+        LED_MATRIX_TEST_LED_FLAGS();
+        led_polar_t polar = led_matrix_polar(i);
+        led_matrix_set_value(i, effect_func(led_matrix_eeconfig.val, polar.angle, polar.dist, time));
+    }
+    return led_matrix_check_finished_leds(led_max);
+}
@@ -4,10 +4,12 @@
 
 typedef uint8_t (*reactive_f)(uint8_t val, uint16_t offset);
 
-bool effect_runner_reactive(effect_params_t* params, reactive_f effect_func) {
+LED_RENDER_RUNNER bool effect_runner_reactive(effect_params_t* params, reactive_f effect_func) {
     LED_MATRIX_USE_LIMITS(led_min, led_max);
 
     uint16_t max_tick = 65535 / led_matrix_eeconfig.speed;
+    // LEDs without a recent hit all show the same value, only render them when they have faded out or been written over
+    led_matrix_sparse_begin(params, effect_func(led_matrix_eeconfig.val, scale16by8(max_tick, led_matrix_eeconfig.speed)));
     for (uint8_t i = led_min; i < led_max; i++) {
         LED_MATRIX_TEST_LED_FLAGS();
         uint16_t tick = max_tick;
@@ -18,9 +20,11 @@ bool effect_runner_reactive(effect_params_t* params, reactive_f effect_func) {
                 break;
             }
         }
+        if (tick == max_tick && !led_matrix_is_dirty(i)) continue;
 
         uint16_t offset = scale16by8(tick, led_matrix_eeconfig.speed);
         led_matrix_set_value(i, effect_func(led_matrix_eeconfig.val, offset));
+        led_matrix_set_dirty(i, tick != max_tick);
     }
     return led_matrix_check_finished_leds(led_max);
 }
@@ -22,15 +22,23 @@ static uint8_t SOLID_REACTIVE_CROSS_math(uint8_t val, int16_t dx, int16_t dy, ui
     return qadd8(val, 255 - effect);
 }
 
+// tick + dist, plus up to 255 more off the cross, has to come out below 255, which it also does when it wraps around
+static reactive_reach_t SOLID_REACTIVE_CROSS_reach(uint16_t tick) {
+    if (tick < 255) {
+        return (reactive_reach_t){.min = 0, .max = 254 - tick};
+    }
+    return (reactive_reach_t){.min = tick > 0x10000 - 255 ? 0 : 0x10000 - 255 - tick, .max = 255};
+}
+
 #            ifdef ENABLE_LED_MATRIX_SOLID_REACTIVE_CROSS
 bool SOLID_REACTIVE_CROSS(effect_params_t* params) {
-    return effect_runner_reactive_splash(qsub8(g_last_hit_tracker.count, 1), params, &SOLID_REACTIVE_CROSS_math);
+    return effect_runner_reactive_splash_sparse(qsub8(g_last_hit_tracker.count, 1), params, &SOLID_REACTIVE_CROSS_math, &SOLID_REACTIVE_CROSS_reach);
 }
 #            endif
 
 #            ifdef ENABLE_LED_MATRIX_SOLID_REACTIVE_MULTICROSS
 bool SOLID_REACTIVE_MULTICROSS(effect_params_t* params) {
-    return effect_runner_reactive_splash(0, params, &SOLID_REACTIVE_CROSS_math);
+    return effect_runner_reactive_splash_sparse(0, params, &SOLID_REACTIVE_CROSS_math, &SOLID_REACTIVE_CROSS_reach);
 }
 #            endif
 
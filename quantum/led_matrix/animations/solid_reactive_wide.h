@@ -17,15 +17,23 @@ static uint8_t SOLID_REACTIVE_WIDE_math(uint8_t val, int16_t dx, int16_t dy, uin
     return qadd8(val, 255 - effect);
 }
 
+// tick + dist * 5 has to come out below 255, which it also does when it wraps around for the last few ticks of a hit
+static reactive_reach_t SOLID_REACTIVE_WIDE_reach(uint16_t tick) {
+    if (tick < 255) {
+        return (reactive_reach_t){.min = 0, .max = (254 - tick) / 5};
+    }
+    return (reactive_reach_t){.min = (0x10000 - tick + 4) / 5, .max = (0x10000 + 254 - tick) / 5};
+}
+
 #            ifdef ENABLE_LED_MATRIX_SOLID_REACTIVE_WIDE
 bool SOLID_REACTIVE_WIDE(effect_params_t* params) {
-    return effect_runner_reactive_splash(qsub8(g_last_hit_tracker.count, 1), params, &SOLID_REACTIVE_WIDE_math);
+    return effect_runner_reactive_splash_sparse(qsub8(g_last_hit_tracker.count, 1), params, &SOLID_REACTIVE_WIDE_math, &SOLID_REACTIVE_WIDE_reach);
 }
 #            endif
 
 #            ifdef ENABLE_LED_MATRIX_SOLID_REACTIVE_MULTIWIDE
 bool SOLID_REACTIVE_MULTIWIDE(effect_params_t* params) {
-    return effect_runner_reactive_splash(0, params, &SOLID_REACTIVE_WIDE_math);
+    return effect_runner_reactive_splash_sparse(0, params, &SOLID_REACTIVE_WIDE_math, &SOLID_REACTIVE_WIDE_reach);
 }
 #            endif
 
@@ -18,6 +18,7 @@
  */
 
 #include "led_matrix.h"
+#include "led_render.h"
 #include "progmem.h"
 #include "eeprom.h"
 #include <string.h>
@@ -32,6 +33,41 @@ const led_point_t k_led_matrix_center = {112, 32};
 const led_point_t k_led_matrix_center = LED_MATRIX_CENTER;
 #endif
 
+#ifdef LED_RENDER_POLAR_TABLE
+static led_polar_t led_matrix_polar_table[LED_MATRIX_LED_COUNT];
+#endif
+
+static inline led_polar_t led_matrix_polar(uint8_t index) {
+#ifdef LED_RENDER_POLAR_TABLE
+    return led_matrix_polar_table[index];
+#else
+    return led_render_polar(g_led_config.point[index], k_led_matrix_center);
+#endif
+}
+
+static uint8_t led_matrix_dirty[LED_RENDER_DIRTY_SIZE(LED_MATRIX_LED_COUNT)];
+static uint8_t led_matrix_idle;
+
+static inline bool led_matrix_is_dirty(uint8_t index) {
+    return led_render_is_dirty(led_matrix_dirty, index);
+}
+
+static inline void led_matrix_set_dirty(uint8_t index, bool dirty) {
+    led_render_set_dirty(led_matrix_dirty, index, dirty);
+}
+
+static inline void led_matrix_set_dirty_all(void) {
+    memset(led_matrix_dirty, 0xFF, sizeof(led_matrix_dirty));
+}
+
+// Called by the sparse effects on each span, with the value they leave the LEDs they don't reach at
+static inline void led_matrix_sparse_begin(effect_params_t *params, uint8_t idle) {
+    if (params->init || idle != led_matrix_idle) {
+        led_matrix_idle = idle;
+        led_matrix_set_dirty_all();
+    }
+}
+
 // Generic effect runners
 #include "led_matrix_runners.inc"
 
@@ -93,11 +129,8 @@ last_hit_t g_last_hit_tracker;
 #endif // LED_MATRIX_KEYREACTIVE_ENABLED
 
 // internals
-static bool            suspend_state     = false;
-static uint8_t         led_last_enable   = UINT8_MAX;
-static uint8_t         led_last_effect   = UINT8_MAX;
-static effect_params_t led_effect_params = {0, LED_FLAG_ALL, false};
-static led_task_states led_task_state    = SYNCING;
+static bool         suspend_state     = false;
+static led_render_t led_matrix_render = LED_RENDER_INIT;
 #if LED_MATRIX_TIMEOUT > 0
 static uint32_t led_anykey_timer;
 #endif // LED_MATRIX_TIMEOUT > 0
@@ -161,6 +194,9 @@ void led_matrix_set_value(int index, uint8_t value) {
     value = pgm_read_byte(&CIE1931_CURVE[value]);
 #endif
     led_matrix_driver.set_value(index, value);
+    if (index >= 0 && index < LED_MATRIX_LED_COUNT) {
+        led_matrix_set_dirty(index, true);
+    }
 }
 
 void led_matrix_set_value_all(uint8_t value) {
@@ -173,6 +209,7 @@ void led_matrix_set_value_all(uint8_t value) {
 #    else
     led_matrix_driver.set_value_all(value);
 #    endif
+    led_matrix_set_dirty_all();
 #endif
 }
 
@@ -261,55 +298,39 @@ static void led_task_timers(void) {
 #endif // LED_MATRIX_KEYREACTIVE_ENABLED
 }
 
-static void led_task_sync(void) {
+static bool led_task_sync(void) {
     eeconfig_flush_led_matrix(false);
-    // next task
-    if (sync_timer_elapsed32(g_led_timer) >= LED_MATRIX_LED_FLUSH_LIMIT) led_task_state = STARTING;
+    return sync_timer_elapsed32(g_led_timer) >= LED_MATRIX_LED_FLUSH_LIMIT;
 }
 
 static void led_task_start(void) {
-    // reset iter
-    led_effect_params.iter = 0;
-
-    // update double buffers
     g_led_timer = led_timer_buffer;
 #ifdef LED_MATRIX_KEYREACTIVE_ENABLED
     g_last_hit_tracker = last_hit_buffer;
 #endif // LED_MATRIX_KEYREACTIVE_ENABLED
-
-    // next task
-    led_task_state = RENDERING;
 }
 
-static void led_task_render(uint8_t effect) {
-    bool rendering         = false;
-    led_effect_params.init = (effect != led_last_effect) || (led_matrix_eeconfig.enable != led_last_enable);
-    if (led_effect_params.flags != led_matrix_eeconfig.flags) {
-        led_effect_params.flags = led_matrix_eeconfig.flags;
-        led_matrix_set_value_all(0);
-    }
+static void led_task_clear(void) {
+    led_matrix_set_value_all(0);
+}
 
-    // each effect can opt to do calculations
-    // and/or request PWM buffer updates.
+static bool led_task_render(uint8_t effect, effect_params_t *params) {
     switch (effect) {
         case LED_MATRIX_NONE:
-            rendering = led_matrix_none(&led_effect_params);
-            break;
+            return led_matrix_none(params);
 
 // ---------------------------------------------
 // -----Begin led effect switch case macros-----
-#define LED_MATRIX_EFFECT(name, ...)          \
-    case LED_MATRIX_##name:                   \
-        rendering = name(&led_effect_params); \
-        break;
+#define LED_MATRIX_EFFECT(name, ...) \
+    case LED_MATRIX_##name:          \
+        return name(params);
 #include "led_matrix_effects.inc"
 #undef LED_MATRIX_EFFECT
 
 #if defined(LED_MATRIX_CUSTOM_KB) || defined(LED_MATRIX_CUSTOM_USER)
-#    define LED_MATRIX_EFFECT(name, ...)          \
-        case LED_MATRIX_CUSTOM_##name:            \
-            rendering = name(&led_effect_params); \
-            break;
+#    define LED_MATRIX_EFFECT(name, ...) \
+        case LED_MATRIX_CUSTOM_##name:   \
+            return name(params);
 #    ifdef LED_MATRIX_CUSTOM_KB
 #        include "led_matrix_kb.inc"
 #    endif
@@ -321,31 +342,23 @@ static void led_task_render(uint8_t effect) {
             // -----End led effect switch case macros-------
             // ---------------------------------------------
     }
-
-    led_effect_params.iter++;
-
-    // next task
-    if (!rendering) {
-        led_task_state = FLUSHING;
-        if (!led_effect_params.init && effect == LED_MATRIX_NONE) {
-            // We only need to flush once if we are LED_MATRIX_NONE
-            led_task_state = SYNCING;
-        }
-    }
+    return false;
 }
 
-static void led_task_flush(uint8_t effect) {
-    // update last trackers after the first full render so we can init over several frames
-    led_last_effect = effect;
-    led_last_enable = led_matrix_eeconfig.enable;
-
-    // update pwm buffers
-    led_matrix_update_pwm_buffers();
-
-    // next task
-    led_task_state = SYNCING;
+static void led_task_indicators(effect_params_t *params) {
+    led_matrix_indicators();
+    led_matrix_indicators_advanced(params);
 }
 
+static const led_render_hooks_t led_matrix_hooks = {
+    .sync       = led_task_sync,
+    .start      = led_task_start,
+    .clear      = led_task_clear,
+    .render     = led_task_render,
+    .indicators = led_task_indicators,
+    .flush      = led_matrix_update_pwm_buffers,
+};
+
 void led_matrix_task(void) {
     led_task_timers();
 
@@ -359,24 +372,7 @@ void led_matrix_task(void) {
 
     uint8_t effect = suspend_backlight || !led_matrix_eeconfig.enable ? 0 : led_matrix_eeconfig.mode;
 
-    switch (led_task_state) {
-        case STARTING:
-            led_task_start();
-            break;
-        case RENDERING:
-            led_task_render(effect);
-            if (effect) {
-                led_matrix_indicators();
-                led_matrix_indicators_advanced(&led_effect_params);
-            }
-            break;
-        case FLUSHING:
-            led_task_flush(effect);
-            break;
-        case SYNCING:
-            led_task_sync();
-            break;
-    }
+    led_render_task(&led_matrix_render, &led_matrix_hooks, effect, led_matrix_eeconfig.enable, led_matrix_eeconfig.flags);
 }
 
 void led_matrix_indicators(void) {
@@ -394,9 +390,9 @@ __attribute__((weak)) bool led_matrix_indicators_user(void) {
 
 void led_matrix_indicators_advanced(effect_params_t *params) {
     /* special handling is needed for "params->iter", since it's already been incremented.
-     * Could move the invocations to led_task_render, but then it's missing a few checks
+     * Could move the invocations to led_render_span, but then it's missing a few checks
      * and not sure which would be better. Otherwise, this should be called from
-     * led_task_render, right before the iter++ line.
+     * led_render_span, right before the iter++ line.
      */
 #if defined(LED_MATRIX_LED_PROCESS_LIMIT) && LED_MATRIX_LED_PROCESS_LIMIT > 0 && LED_MATRIX_LED_PROCESS_LIMIT < LED_MATRIX_LED_COUNT
     uint8_t min = LED_MATRIX_LED_PROCESS_LIMIT * (params->iter - 1);
@@ -421,6 +417,10 @@ __attribute__((weak)) bool led_matrix_indicators_advanced_user(uint8_t led_min,
 void led_matrix_init(void) {
     led_matrix_driver.init();
 
+#ifdef LED_RENDER_POLAR_TABLE
+    led_render_polar_init(led_matrix_polar_table, g_led_config.point, LED_MATRIX_LED_COUNT, k_led_matrix_center);
+#endif
+
 #ifdef LED_MATRIX_KEYREACTIVE_ENABLED
     g_last_hit_tracker.count = 0;
     for (uint8_t i = 0; i < LED_HITS_TO_REMEMBER; ++i) {
@@ -450,8 +450,8 @@ void led_matrix_init(void) {
 void led_matrix_set_suspend_state(bool state) {
 #ifdef LED_DISABLE_WHEN_USB_SUSPENDED
     if (state && !suspend_state && is_keyboard_master()) { // only run if turning off, and only once
-        led_task_render(0);                                // turn off all LEDs when suspending
-        led_task_flush(0);                                 // and actually flash led state to LEDs
+        // turn off all LEDs when suspending, and actually flash led state to LEDs
+        led_render_now(&led_matrix_render, &led_matrix_hooks, 0, led_matrix_eeconfig.enable, led_matrix_eeconfig.flags);
     }
     suspend_state = state;
 #endif
@@ -463,7 +463,7 @@ bool led_matrix_get_suspend_state(void) {
 
 void led_matrix_toggle_eeprom_helper(bool write_to_eeprom) {
     led_matrix_eeconfig.enable ^= 1;
-    led_task_state = STARTING;
+    led_render_restart(&led_matrix_render);
     eeconfig_flag_led_matrix(write_to_eeprom);
     dprintf("led matrix toggle [%s]: led_matrix_eeconfig.enable = %u\n", (write_to_eeprom) ? "EEPROM" : "NOEEPROM", led_matrix_eeconfig.enable);
 }
@@ -480,7 +480,7 @@ void led_matrix_enable(void) {
 }
 
 void led_matrix_enable_noeeprom(void) {
-    if (!led_matrix_eeconfig.enable) led_task_state = STARTING;
+    if (!led_matrix_eeconfig.enable) led_render_restart(&led_matrix_render);
     led_matrix_eeconfig.enable = 1;
 }
 
@@ -490,7 +490,7 @@ void led_matrix_disable(void) {
 }
 
 void led_matrix_disable_noeeprom(void) {
-    if (led_matrix_eeconfig.enable) led_task_state = STARTING;
+    if (led_matrix_eeconfig.enable) led_render_restart(&led_matrix_render);
     led_matrix_eeconfig.enable = 0;
 }
 
@@ -509,7 +509,7 @@ void led_matrix_mode_eeprom_helper(uint8_t mode, bool write_to_eeprom) {
     } else {
         led_matrix_eeconfig.mode = mode;
     }
-    led_task_state = STARTING;
+    led_render_restart(&led_matrix_render);
     eeconfig_flag_led_matrix(write_to_eeprom);
     dprintf("led matrix mode [%s]: %u\n", (write_to_eeprom) ? "EEPROM" : "NOEEPROM", led_matrix_eeconfig.mode);
 }
@@ -0,0 +1,94 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "led_render.h"
+
+#include <lib/lib8tion/lib8tion.h>
+
+static void led_render_sync(led_render_t *render, const led_render_hooks_t *hooks) {
+    // next task
+    if (hooks->sync()) render->state = STARTING;
+}
+
+static void led_render_start(led_render_t *render, const led_render_hooks_t *hooks) {
+    // reset iter
+    render->params.iter = 0;
+
+    // update double buffers
+    hooks->start();
+
+    // next task
+    render->state = RENDERING;
+}
+
+static void led_render_span(led_render_t *render, const led_render_hooks_t *hooks, uint8_t effect, uint8_t enable, led_flags_t flags) {
+    render->params.init = (effect != render->last_effect) || (enable != render->last_enable);
+    if (render->params.flags != flags) {
+        render->params.flags = flags;
+        hooks->clear();
+    }
+
+    // each effect can opt to do calculations
+    // and/or request PWM buffer updates.
+    bool rendering = hooks->render(effect, &render->params);
+
+    render->params.iter++;
+
+    // next task
+    if (!rendering) {
+        render->state = FLUSHING;
+        if (!render->params.init && effect == 0) {
+            // We only need to flush once if the LEDs are off
+            render->state = SYNCING;
+        }
+    }
+}
+
+static void led_render_flush(led_render_t *render, const led_render_hooks_t *hooks, uint8_t effect, uint8_t enable) {
+    // update last trackers after the first full render so we can init over several frames
+    render->last_effect = effect;
+    render->last_enable = enable;
+
+    // update pwm buffers
+    hooks->flush();
+
+    // next task
+    render->state = SYNCING;
+}
+
+void led_render_task(led_render_t *render, const led_render_hooks_t *hooks, uint8_t effect, uint8_t enable, led_flags_t flags) {
+    switch (render->state) {
+        case STARTING:
+            led_render_start(render, hooks);
+            break;
+        case RENDERING:
+            led_render_span(render, hooks, effect, enable, flags);
+            if (effect) {
+                hooks->indicators(&render->params);
+            }
+            break;
+        case FLUSHING:
+            led_render_flush(render, hooks, effect, enable);
+            break;
+        case SYNCING:
+            led_render_sync(render, hooks);
+            break;
+    }
+}
+
+void led_render_now(led_render_t *render, const led_render_hooks_t *hooks, uint8_t effect, uint8_t enable, led_flags_t flags) {
+    led_render_span(render, hooks, effect, enable, flags);
+    led_render_flush(render, hooks, effect, enable);
+}
+
+led_polar_t led_render_polar(led_point_t point, led_point_t center) {
+    int16_t dx = point.x - center.x;
+    int16_t dy = point.y - center.y;
+    return (led_polar_t){.angle = atan2_8(dy, dx), .dist = sqrt16(dx * dx + dy * dy)};
+}
+
+void led_render_polar_init(led_polar_t *table, const led_point_t *points, uint8_t count, led_point_t center) {
+    for (uint8_t i = 0; i < count; i++) {
+        table[i] = led_render_polar(points[i], center);
+    }
+}
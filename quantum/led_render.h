@@ -0,0 +1,103 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#if defined(RGB_MATRIX_ENABLE)
+#    include "rgb_matrix_types.h"
+#elif defined(LED_MATRIX_ENABLE)
+#    include "led_matrix_types.h"
+#endif
+
+/* Render core shared by LED Matrix and RGB Matrix.
+ *
+ * Both run the same frame state machine: wait for the flush interval, latch the
+ * double buffered timers (STARTING), render the effect over one span of LEDs per
+ * call (RENDERING), push the buffers to the driver (FLUSHING), and write back the
+ * config (SYNCING). Only the hooks differ between the two.
+ */
+
+/* Effect runners are inlined into each effect, so every effect gets its own span
+ * loop with the per-LED math inlined rather than called through a pointer, which
+ * the compiler can then unroll and vectorise. AVR keeps a single shared copy of
+ * each runner, as the extra code does not fit there. */
+#if defined(__AVR__) || defined(LED_RENDER_SHARED_RUNNERS)
+#    define LED_RENDER_RUNNER static inline
+#else
+#    define LED_RENDER_RUNNER static inline __attribute__((always_inline))
+#endif
+
+/* The pinwheel, spiral and out-in effects look up the angle and distance of each
+ * LED from the center in a table built at init, rather than working them out for
+ * every LED on every frame. AVR computes them on the fly, to save the RAM. */
+#if !defined(__AVR__) && !defined(LED_RENDER_NO_POLAR_TABLE)
+#    define LED_RENDER_POLAR_TABLE
+#endif
+
+/* The reactive effects only render the LEDs their hits reach, plus those marked
+ * dirty: the ones that may be showing anything other than the color the effect
+ * leaves untouched LEDs at, because a hit just faded out of them or something
+ * else, like an indicator, wrote to them. One bit per LED. */
+#define LED_RENDER_DIRTY_SIZE(count) (((count) + 7) / 8)
+
+typedef struct led_polar_t {
+    uint8_t angle; // atan2_8() of the offset from the center
+    uint8_t dist;  // sqrt16() of the squared distance from the center
+} led_polar_t;
+
+typedef struct led_render_hooks_t {
+    /* Called while idle, returns true once the next frame is due. */
+    bool (*sync)(void);
+    /* Latches the double buffered state for the new frame. */
+    void (*start)(void);
+    /* Turns off every LED, when the flags change. */
+    void (*clear)(void);
+    /* Renders the current span of `effect`, returns true while there are LEDs left. */
+    bool (*render)(uint8_t effect, effect_params_t *params);
+    /* Runs the indicator callbacks over the span that was just rendered. */
+    void (*indicators)(effect_params_t *params);
+    /* Pushes the rendered frame to the driver. */
+    void (*flush)(void);
+} led_render_hooks_t;
+
+typedef struct led_render_t {
+    uint8_t         state;
+    uint8_t         last_effect;
+    uint8_t         last_enable;
+    effect_params_t params;
+} led_render_t;
+
+#define LED_RENDER_INIT \
+    { .state = SYNCING, .last_effect = UINT8_MAX, .last_enable = UINT8_MAX, .params = {0, LED_FLAG_ALL, false} }
+
+/* Advances the state machine by one step, `effect` being 0 while the LEDs are off. */
+void led_render_task(led_render_t *render, const led_render_hooks_t *hooks, uint8_t effect, uint8_t enable, led_flags_t flags);
+
+/* Renders and flushes `effect` in one go, e.g. to turn the LEDs off when suspending. */
+void led_render_now(led_render_t *render, const led_render_hooks_t *hooks, uint8_t effect, uint8_t enable, led_flags_t flags);
+
+/* Starts over with a new frame, after a change of mode or enable state. */
+static inline void led_render_restart(led_render_t *render) {
+    render->state = STARTING;
+}
+
+/* Angle and distance of `point` from `center`, as the polar effect runners see them. */
+led_polar_t led_render_polar(led_point_t point, led_point_t center);
+
+/* Fills `table` with the polar coordinates of the first `count` of `points`. */
+void led_render_polar_init(led_polar_t *table, const led_point_t *points, uint8_t count, led_point_t center);
+
+static inline bool led_render_is_dirty(const uint8_t *dirty, uint8_t index) {
+    return dirty[index / 8] & (1 << (index % 8));
+}
+
+static inline void led_render_set_dirty(uint8_t *dirty, uint8_t index, bool value) {
+    if (value) {
+        dirty[index / 8] |= 1 << (index % 8);
+    } else {
+        dirty[index / 8] &= ~(1 << (index % 8));
+    }
+}
@@ -3,10 +3,21 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include "qp_lvgl.h"
+#include "qp_comms.h"
 #include "timer.h"
 #include "deferred_exec.h"
 #include "lvgl.h"
 
+// Upper bound on the time between lv_timer_handler() invocations, regardless of what LVGL asks for
+#ifndef QP_LVGL_TASK_HANDLER_MAX_PERIOD
+#    define QP_LVGL_TASK_HANDLER_MAX_PERIOD LV_DISP_DEF_REFR_PERIOD
+#endif
+
+// Time an asynchronous pixel transfer is given to complete before it is aborted
+#ifndef QP_LVGL_ASYNC_FLUSH_TIMEOUT
+#    define QP_LVGL_ASYNC_FLUSH_TIMEOUT 100
+#endif
+
 typedef struct lvgl_state_t {
     uint8_t        fnc_id; // Ideally this should be the pointer of the function to run
     uint16_t       delay_ms;
@@ -18,14 +29,73 @@ static lvgl_state_t        lvgl_states[2]    = {0}; // For lv_tick_inc and lv_ta
 
 painter_device_t selected_display = NULL;
 void *           color_buffer     = NULL;
+void *           color_buffer_2   = NULL;
+
+// Set while an asynchronous pixel transfer owns the display's comms, cleared once comms have been released
+static bool           async_flush_active = false;
+static volatile bool  async_flush_done   = false;
+static uint32_t       async_flush_start  = 0;
+static lv_disp_drv_t *async_flush_disp   = NULL;
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Quantum Painter LVGL Integration Internal: qp_lvgl_flush
 
+static void qp_lvgl_flush_complete(void *cb_arg) {
+    // Invoked from the transfer-complete interrupt, LVGL may start rendering into this buffer again straight away
+    async_flush_done = true;
+    lv_disp_flush_ready((lv_disp_drv_t *)cb_arg);
+}
+
+static bool qp_lvgl_can_flush_async(painter_device_t device) {
+    painter_driver_t *driver = (painter_driver_t *)device;
+    return driver->driver_vtable->pixdata_async && driver->comms_vtable->comms_send_async;
+}
+
+// Releases comms once the asynchronous transfer is done, or aborts it once it has timed out. Returns false if the
+// transfer is still in flight, which only happens without `wait`.
+static bool qp_lvgl_flush_finish(bool wait) {
+    if (!async_flush_active) {
+        return true;
+    }
+
+    while (!async_flush_done && TIMER_DIFF_32(timer_read32(), async_flush_start) < (QP_LVGL_ASYNC_FLUSH_TIMEOUT)) {
+        if (!wait) {
+            return false;
+        }
+    }
+
+    // Stopping comms aborts the transfer if it is still running, its completion callback cannot fire after this
+    qp_comms_stop(selected_display);
+    async_flush_active = false;
+    if (!async_flush_done) {
+        qp_dprintf("qp_lvgl_flush: async transfer timed out\n");
+        lv_disp_flush_ready(async_flush_disp);
+    }
+    return true;
+}
+
 void qp_lvgl_flush(lv_disp_drv_t *disp, const lv_area_t *area, lv_color_t *color_p) {
     if (selected_display) {
-        uint32_t number_pixels = (area->x2 - area->x1 + 1) * (area->y2 - area->y1 + 1);
+        painter_driver_t *driver        = (painter_driver_t *)selected_display;
+        uint32_t          number_pixels = (area->x2 - area->x1 + 1) * (area->y2 - area->y1 + 1);
+
+        // Release comms from the previous transfer before talking to the display again
+        qp_lvgl_flush_finish(true);
+
         qp_viewport(selected_display, area->x1, area->y1, area->x2, area->y2);
+
+        if (qp_lvgl_can_flush_async(selected_display) && qp_comms_start(selected_display)) {
+            async_flush_done   = false;
+            async_flush_active = true;
+            async_flush_start  = timer_read32();
+            async_flush_disp   = disp;
+            if (driver->driver_vtable->pixdata_async(selected_display, (void *)color_p, number_pixels, qp_lvgl_flush_complete, disp)) {
+                return;
+            }
+            qp_comms_stop(selected_display);
+            async_flush_active = false;
+        }
+
         qp_pixdata(selected_display, (void *)color_p, number_pixels);
         qp_flush(selected_display);
         lv_disp_flush_ready(disp);
@@ -41,9 +111,11 @@ static uint32_t tick_task_callback(uint32_t trigger_time, void *cb_arg) {
             lv_tick_inc(TIMER_DIFF_32(now, last_tick));
             last_tick = now;
         } break;
-        case 1:
-            lv_task_handler();
-            break;
+        case 1: {
+            // Reschedule based on LVGL's own next timer deadline, rather than polling at a fixed rate
+            uint32_t next_run = lv_timer_handler();
+            return QP_MAX(1, QP_MIN(next_run, QP_LVGL_TASK_HANDLER_MAX_PERIOD));
+        }
 
         default:
             break;
@@ -68,6 +140,7 @@ bool qp_lvgl_attach(painter_device_t device) {
     }
 
     // Setting up the tasks
+#if !LV_TICK_CUSTOM
     lvgl_state_t *lv_tick_inc_state = &lvgl_states[0];
     lv_tick_inc_state->fnc_id       = 0;
     lv_tick_inc_state->delay_ms     = 1;
@@ -78,11 +151,12 @@ bool qp_lvgl_attach(painter_device_t device) {
         qp_lvgl_detach();
         return false;
     }
+#endif // !LV_TICK_CUSTOM
 
     lvgl_state_t *lv_task_handler_state = &lvgl_states[1];
     lv_task_handler_state->fnc_id       = 1;
     lv_task_handler_state->delay_ms     = 5;
-    lv_task_handler_state->defer_token  = defer_exec_advanced(lvgl_executors, 2, 5, tick_task_callback, lv_task_handler_state);
+    lv_task_handler_state->defer_token  = defer_exec_advanced(lvgl_executors, 2, 1, tick_task_callback, lv_task_handler_state);
 
     if (lv_task_handler_state->defer_token == INVALID_DEFERRED_TOKEN) {
         qp_dprintf("qp_lvgl_attach: fail (could not set up qp_lvgl executor)\n");
@@ -104,8 +178,18 @@ bool qp_lvgl_attach(painter_device_t device) {
         return false;
     }
     memset(color_buffer, 0, sizeof(lv_color_t) * count_required);
+
+    // A second buffer lets LVGL render the next area while the previous one is being transferred.
+    // If the display can't transfer asynchronously, or there isn't enough memory, fall back to a single buffer.
+    if (qp_lvgl_can_flush_async(device)) {
+        color_buffer_2 = color_buffer_2 ? realloc(color_buffer_2, sizeof(lv_color_t) * count_required) : malloc(sizeof(lv_color_t) * count_required);
+    } else if (color_buffer_2) {
+        free(color_buffer_2);
+        color_buffer_2 = NULL;
+    }
+
     // Initialize the display buffer.
-    lv_disp_draw_buf_init(&draw_buf, color_buffer, NULL, count_required);
+    lv_disp_draw_buf_init(&draw_buf, color_buffer, color_buffer_2, count_required);
 
     selected_display = device;
 
@@ -134,10 +218,15 @@ void qp_lvgl_detach(void) {
     for (int i = 0; i < 2; ++i) {
         cancel_deferred_exec_advanced(lvgl_executors, 2, lvgl_states[i].defer_token);
     }
+    qp_lvgl_flush_finish(true);
     if (color_buffer) {
         free(color_buffer);
         color_buffer = NULL;
     }
+    if (color_buffer_2) {
+        free(color_buffer_2);
+        color_buffer_2 = NULL;
+    }
     selected_display = NULL;
 }
 
@@ -148,3 +237,10 @@ void qp_lvgl_internal_tick(void) {
     static uint32_t last_lvgl_exec = 0;
     deferred_exec_advanced_task(lvgl_executors, 2, &last_lvgl_exec);
 }
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Quantum Painter LVGL Integration Internal: qp_lvgl_internal_housekeeping
+
+bool qp_lvgl_internal_housekeeping(void) {
+    return qp_lvgl_flush_finish(false);
+}
@@ -46,6 +46,21 @@ uint32_t qp_comms_send(painter_device_t device, const void *data, uint32_t byte_
     return driver->comms_vtable->comms_send(device, data, byte_count);
 }
 
+bool qp_comms_send_async(painter_device_t device, const void *data, uint32_t byte_count, painter_async_complete_func callback, void *cb_arg) {
+    painter_driver_t *driver = (painter_driver_t *)device;
+    if (!driver->validate_ok) {
+        qp_dprintf("qp_comms_send_async: fail (validation_ok == false)\n");
+        return false;
+    }
+
+    // Not all comms drivers can transmit asynchronously -- callers fall back to qp_comms_send()
+    if (!driver->comms_vtable->comms_send_async) {
+        return false;
+    }
+
+    return driver->comms_vtable->comms_send_async(device, data, byte_count, callback, cb_arg);
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Comms APIs that use a D/C pin
 
@@ -65,6 +65,14 @@ static void qp_internal_display_timeout_task(void) {
 _Static_assert((QUANTUM_PAINTER_TASK_THROTTLE) > 0 && (QUANTUM_PAINTER_TASK_THROTTLE) < 1000, "QUANTUM_PAINTER_TASK_THROTTLE must be between 1 and 999");
 
 void qp_internal_task(void) {
+#ifdef QUANTUM_PAINTER_LVGL_INTEGRATION_ENABLE
+    // Release the display's comms as soon as an asynchronous LVGL transfer is done, and leave them alone until then
+    bool qp_lvgl_internal_housekeeping(void);
+    if (!qp_lvgl_internal_housekeeping()) {
+        return;
+    }
+#endif
+
     // Perform throttling of the internal processing of Quantum Painter
     static uint32_t last_tick = 0;
     uint32_t        now       = timer_read32();
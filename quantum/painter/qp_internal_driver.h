@@ -8,12 +8,16 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Driver callbacks
 
+// Completion callback for asynchronous transfers, may be invoked from interrupt context
+typedef void (*painter_async_complete_func)(void *cb_arg);
+
 typedef bool (*painter_driver_init_func)(painter_device_t device, painter_rotation_t rotation);
 typedef bool (*painter_driver_power_func)(painter_device_t device, bool power_on);
 typedef bool (*painter_driver_clear_func)(painter_device_t device);
 typedef bool (*painter_driver_flush_func)(painter_device_t device);
 typedef bool (*painter_driver_viewport_func)(painter_device_t device, uint16_t left, uint16_t top, uint16_t right, uint16_t bottom);
 typedef bool (*painter_driver_pixdata_func)(painter_device_t device, const void *pixel_data, uint32_t native_pixel_count);
+typedef bool (*painter_driver_pixdata_async_func)(painter_device_t device, const void *pixel_data, uint32_t native_pixel_count, painter_async_complete_func callback, void *cb_arg);
 typedef bool (*painter_driver_convert_palette_func)(painter_device_t device, int16_t palette_size, qp_pixel_t *palette);
 typedef bool (*painter_driver_append_pixels)(painter_device_t device, uint8_t *target_buffer, qp_pixel_t *palette, uint32_t pixel_offset, uint32_t pixel_count, uint8_t *palette_indices);
 typedef bool (*painter_driver_append_pixdata)(painter_device_t device, uint8_t *target_buffer, uint32_t pixdata_offset, uint8_t pixdata_byte);
@@ -29,6 +33,7 @@ typedef struct painter_driver_vtable_t {
     painter_driver_convert_palette_func palette_convert;
     painter_driver_append_pixels        append_pixels;
     painter_driver_append_pixdata       append_pixdata;
+    painter_driver_pixdata_async_func   pixdata_async; // optional
 } painter_driver_vtable_t;
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -38,12 +43,14 @@ typedef bool (*painter_driver_comms_init_func)(painter_device_t device);
 typedef bool (*painter_driver_comms_start_func)(painter_device_t device);
 typedef void (*painter_driver_comms_stop_func)(painter_device_t device);
 typedef uint32_t (*painter_driver_comms_send_func)(painter_device_t device, const void *data, uint32_t byte_count);
+typedef bool (*painter_driver_comms_send_async_func)(painter_device_t device, const void *data, uint32_t byte_count, painter_async_complete_func callback, void *cb_arg);
 
 typedef struct painter_comms_vtable_t {
-    painter_driver_comms_init_func  comms_init;
-    painter_driver_comms_start_func comms_start;
-    painter_driver_comms_stop_func  comms_stop;
-    painter_driver_comms_send_func  comms_send;
+    painter_driver_comms_init_func       comms_init;
+    painter_driver_comms_start_func      comms_start;
+    painter_driver_comms_stop_func       comms_stop;
+    painter_driver_comms_send_func       comms_send;
+    painter_driver_comms_send_async_func comms_send_async; // optional
 } painter_comms_vtable_t;
 
 typedef void (*painter_driver_comms_send_command_func)(painter_device_t device, uint8_t cmd);
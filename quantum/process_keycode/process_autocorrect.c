@@ -14,6 +14,20 @@
 #    include "autocorrect_data_default.h"
 #endif
 
+// Headers generated before branch nodes were sorted don't say which encoding they use
+#ifndef AUTOCORRECT_DATA_VERSION
+#    define AUTOCORRECT_DATA_VERSION 1
+#endif
+#ifndef AUTOCORRECT_LINK_SIZE
+#    define AUTOCORRECT_LINK_SIZE 2
+#endif
+
+#if AUTOCORRECT_LINK_SIZE > 2
+typedef uint32_t autocorrect_offset_t;
+#else
+typedef uint16_t autocorrect_offset_t;
+#endif
+
 static uint8_t typo_buffer[AUTOCORRECT_MAX_LENGTH] = {KC_SPC};
 static uint8_t typo_buffer_size                    = 1;
 
@@ -56,6 +70,115 @@ void autocorrect_toggle(void) {
     eeconfig_update_keymap(keymap_config.raw);
 }
 
+#if AUTOCORRECT_DATA_VERSION >= 2
+/**
+ * @brief Reads a link to a trie node
+ *
+ * @param offset where the link is stored in `autocorrect_data`
+ * @return autocorrect_offset_t offset of the linked node
+ */
+static autocorrect_offset_t autocorrect_read_link(autocorrect_offset_t offset) {
+    autocorrect_offset_t link = pgm_read_byte(autocorrect_data + offset) | pgm_read_byte(autocorrect_data + offset + 1) << 8;
+#    if AUTOCORRECT_LINK_SIZE > 2
+    link |= (autocorrect_offset_t)pgm_read_byte(autocorrect_data + offset + 2) << 16;
+#    endif
+    return link;
+}
+
+/**
+ * @brief Looks the typo buffer up in the trie stored in `autocorrect_data`
+ *
+ * Branch nodes hold their child count, the sorted child keys and then a link per child, so the
+ * child for a key is found with a binary search rather than by walking the list.
+ *
+ * @return autocorrect_offset_t offset of the matching leaf node, 0 if the buffer doesn't end with a typo
+ */
+static autocorrect_offset_t autocorrect_lookup(void) {
+    autocorrect_offset_t state = 0;
+    for (int8_t i = typo_buffer_size - 1; i >= 0; --i) {
+        uint8_t const key_i = typo_buffer[i];
+        uint8_t       code  = pgm_read_byte(autocorrect_data + state);
+
+        if (code & 64) { // Check for match in node with multiple children.
+            uint8_t const count = code & 63;
+            uint8_t       lo    = 0;
+            uint8_t       hi    = count;
+            while (lo < hi) {
+                uint8_t const mid = (lo + hi) / 2;
+                if (pgm_read_byte(autocorrect_data + state + 1 + mid) < key_i) {
+                    lo = mid + 1;
+                } else {
+                    hi = mid;
+                }
+            }
+            if (lo == count || pgm_read_byte(autocorrect_data + state + 1 + lo) != key_i) {
+                return 0;
+            }
+            // Follow link to child node.
+            state = autocorrect_read_link(state + 1 + count + lo * AUTOCORRECT_LINK_SIZE);
+            // Check for match in node with single child.
+        } else if (code != key_i) {
+            return 0;
+        } else if (!pgm_read_byte(autocorrect_data + (++state))) {
+            ++state;
+        }
+
+        // Stop if `state` becomes an invalid index. This should not normally
+        // happen, it is a safeguard in case of a bug, data corruption, etc.
+        if (state >= DICTIONARY_SIZE) {
+            return 0;
+        }
+
+        if (pgm_read_byte(autocorrect_data + state) & 128) {
+            return state;
+        }
+    }
+    return 0;
+}
+#else
+/**
+ * @brief Looks the typo buffer up in the trie stored in `autocorrect_data`
+ *
+ * Legacy encoding, where the children of a branch node are scanned one by one.
+ *
+ * @return autocorrect_offset_t offset of the matching leaf node, 0 if the buffer doesn't end with a typo
+ */
+static autocorrect_offset_t autocorrect_lookup(void) {
+    autocorrect_offset_t state = 0;
+    uint8_t              code  = pgm_read_byte(autocorrect_data + state);
+    for (int8_t i = typo_buffer_size - 1; i >= 0; --i) {
+        uint8_t const key_i = typo_buffer[i];
+
+        if (code & 64) { // Check for match in node with multiple children.
+            code &= 63;
+            for (; code != key_i; code = pgm_read_byte(autocorrect_data + (state += 3))) {
+                if (!code) return 0;
+            }
+            // Follow link to child node.
+            state = (pgm_read_byte(autocorrect_data + state + 1) | pgm_read_byte(autocorrect_data + state + 2) << 8);
+            // Check for match in node with single child.
+        } else if (code != key_i) {
+            return 0;
+        } else if (!(code = pgm_read_byte(autocorrect_data + (++state)))) {
+            ++state;
+        }
+
+        // Stop if `state` becomes an invalid index. This should not normally
+        // happen, it is a safeguard in case of a bug, data corruption, etc.
+        if (state >= DICTIONARY_SIZE) {
+            return 0;
+        }
+
+        code = pgm_read_byte(autocorrect_data + state);
+
+        if (code & 128) {
+            return state;
+        }
+    }
+    return 0;
+}
+#endif
+
 /**
  * @brief handler for determining if autocorrect should process keypress
  *
@@ -255,51 +378,26 @@ bool process_autocorrect(uint16_t keycode, keyrecord_t *record) {
     }
 
     // Check for typo in buffer using a trie stored in `autocorrect_data`.
-    uint16_t state = 0;
-    uint8_t  code  = pgm_read_byte(autocorrect_data + state);
-    for (int8_t i = typo_buffer_size - 1; i >= 0; --i) {
-        uint8_t const key_i = typo_buffer[i];
-
-        if (code & 64) { // Check for match in node with multiple children.
-            code &= 63;
-            for (; code != key_i; code = pgm_read_byte(autocorrect_data + (state += 3))) {
-                if (!code) return true;
-            }
-            // Follow link to child node.
-            state = (pgm_read_byte(autocorrect_data + state + 1) | pgm_read_byte(autocorrect_data + state + 2) << 8);
-            // Check for match in node with single child.
-        } else if (code != key_i) {
-            return true;
-        } else if (!(code = pgm_read_byte(autocorrect_data + (++state)))) {
-            ++state;
-        }
+    autocorrect_offset_t state = autocorrect_lookup();
+    if (!state) {
+        return true;
+    }
 
-        // Stop if `state` becomes an invalid index. This should not normally
-        // happen, it is a safeguard in case of a bug, data corruption, etc.
-        if (state >= DICTIONARY_SIZE) {
-            return true;
+    // A typo was found! Apply autocorrect.
+    const uint8_t backspaces = (pgm_read_byte(autocorrect_data + state) & 63) + !record->event.pressed;
+    if (apply_autocorrect(backspaces, (char const *)(autocorrect_data + state + 1))) {
+        for (uint8_t i = 0; i < backspaces; ++i) {
+            tap_code(KC_BSPC);
         }
+        send_string_P((char const *)(autocorrect_data + state + 1));
+    }
 
-        code = pgm_read_byte(autocorrect_data + state);
-
-        if (code & 128) { // A typo was found! Apply autocorrect.
-            const uint8_t backspaces = (code & 63) + !record->event.pressed;
-            if (apply_autocorrect(backspaces, (char const *)(autocorrect_data + state + 1))) {
-                for (uint8_t i = 0; i < backspaces; ++i) {
-                    tap_code(KC_BSPC);
-                }
-                send_string_P((char const *)(autocorrect_data + state + 1));
-            }
-
-            if (keycode == KC_SPC) {
-                typo_buffer[0]   = KC_SPC;
-                typo_buffer_size = 1;
-                return true;
-            } else {
-                typo_buffer_size = 0;
-                return false;
-            }
-        }
+    if (keycode == KC_SPC) {
+        typo_buffer[0]   = KC_SPC;
+        typo_buffer_size = 1;
+        return true;
+    } else {
+        typo_buffer_size = 0;
+        return false;
     }
-    return true;
 }
@@ -26,8 +26,11 @@
 #    define KEY_OVERRIDE_REPEAT_DELAY 500
 #endif
 
-// For benchmarking the time it takes to call process_key_override on every key press (needs keyboard debugging enabled as well)
-// #define BENCH_KEY_OVERRIDE
+// How many overrides can be indexed by trigger keycode, longer lists are scanned in full on every event
+#ifndef KEY_OVERRIDE_INDEX_SIZE
+#    define KEY_OVERRIDE_INDEX_SIZE 32
+#endif
+_Static_assert(KEY_OVERRIDE_INDEX_SIZE <= 255, "KEY_OVERRIDE_INDEX_SIZE must be 255 or less");
 
 // For debug output (needs keyboard debugging enabled as well)
 // #define DEBUG_KEY_OVERRIDE
@@ -81,6 +84,12 @@ static uint16_t deferred_register = 0;
 // TODO: in future maybe save in EEPROM?
 static bool enabled = true;
 
+// Indices into key_overrides sorted by trigger keycode, ties keep the order of key_overrides
+static uint8_t                key_override_index[KEY_OVERRIDE_INDEX_SIZE];
+static uint8_t                key_override_index_count = 0;
+static const key_override_t **indexed_key_overrides    = NULL;
+static bool                   key_override_index_valid = false;
+
 // Public variables
 __attribute__((weak)) const key_override_t **key_overrides = NULL;
 
@@ -243,19 +252,122 @@ static bool check_activation_event(const key_override_t *override, const bool ke
     }
 }
 
-/** Iterates through the list of key overrides and tries activating each, until it finds one that activates or reaches the end of overrides. Returns true if the key action for `keycode` should be sent */
+/** Sorts the overrides by trigger keycode, so the ones that can activate for a keycode are found with a binary search. Rebuilt whenever key_overrides points at a different list. */
+static void key_override_build_index(void) {
+    indexed_key_overrides    = key_overrides;
+    key_override_index_count = 0;
+    key_override_index_valid = true;
+
+    for (uint8_t i = 0; key_overrides[i] != NULL; i++) {
+        if (i == KEY_OVERRIDE_INDEX_SIZE) {
+            key_override_printf("Too many overrides to index, increase KEY_OVERRIDE_INDEX_SIZE\n");
+            key_override_index_valid = false;
+            return;
+        }
+
+        // Insertion sort, stable so that overrides sharing a trigger stay in the order they are listed in
+        const uint16_t trigger = key_overrides[i]->trigger;
+        uint8_t        j       = i;
+        for (; j > 0 && key_overrides[key_override_index[j - 1]]->trigger > trigger; j--) {
+            key_override_index[j] = key_override_index[j - 1];
+        }
+        key_override_index[j]    = i;
+        key_override_index_count = i + 1;
+    }
+}
+
+/** Returns the position of the first indexed override whose trigger is not below `trigger`. */
+static uint8_t key_override_index_lower_bound(const uint16_t trigger) {
+    uint8_t lo = 0;
+    uint8_t hi = key_override_index_count;
+    while (lo < hi) {
+        const uint8_t mid = (lo + hi) / 2;
+        if (key_overrides[key_override_index[mid]]->trigger < trigger) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+// At most three triggers can let an event activate an override: KC_NO, the last non-mod key pressed, and the key of the event itself
+#define KEY_OVERRIDE_MAX_CANDIDATE_RANGES 3
+
+typedef struct {
+    uint8_t next[KEY_OVERRIDE_MAX_CANDIDATE_RANGES];
+    uint8_t end[KEY_OVERRIDE_MAX_CANDIDATE_RANGES];
+    uint8_t ranges;
+    uint8_t linear; // Next override to try when the list isn't indexed
+} key_override_candidates_t;
+
+static void key_override_candidates_add(key_override_candidates_t *candidates, const uint16_t trigger) {
+    for (uint8_t r = 0; r < candidates->ranges; r++) {
+        if (key_overrides[key_override_index[candidates->next[r]]]->trigger == trigger) {
+            return;
+        }
+    }
+
+    uint8_t start = key_override_index_lower_bound(trigger);
+    uint8_t end   = start;
+    while (end < key_override_index_count && key_overrides[key_override_index[end]]->trigger == trigger) {
+        end++;
+    }
+    if (start != end) {
+        candidates->next[candidates->ranges] = start;
+        candidates->end[candidates->ranges]  = end;
+        candidates->ranges++;
+    }
+}
+
+/** Collects the overrides that can possibly activate for an event on `keycode`, any other override has the wrong trigger. */
+static void key_override_candidates_init(key_override_candidates_t *candidates, const uint16_t keycode) {
+    candidates->ranges = 0;
+    candidates->linear = 0;
+
+    if (key_overrides != indexed_key_overrides) {
+        key_override_build_index();
+    }
+    if (!key_override_index_valid) {
+        return;
+    }
+
+    key_override_candidates_add(candidates, KC_NO);
+    key_override_candidates_add(candidates, keycode);
+    key_override_candidates_add(candidates, last_key_down);
+}
+
+/** Returns the next candidate override in the order of key_overrides, or NULL when there are none left. */
+static const key_override_t *key_override_candidates_next(key_override_candidates_t *candidates) {
+    if (!key_override_index_valid) {
+        return key_overrides[candidates->linear++];
+    }
+
+    // Each range is in key_overrides order already, merge them by taking the lowest index first
+    uint8_t best = KEY_OVERRIDE_MAX_CANDIDATE_RANGES;
+    for (uint8_t r = 0; r < candidates->ranges; r++) {
+        if (candidates->next[r] < candidates->end[r] && (best == KEY_OVERRIDE_MAX_CANDIDATE_RANGES || key_override_index[candidates->next[r]] < key_override_index[candidates->next[best]])) {
+            best = r;
+        }
+    }
+    if (best == KEY_OVERRIDE_MAX_CANDIDATE_RANGES) {
+        return NULL;
+    }
+    return key_overrides[key_override_index[candidates->next[best]++]];
+}
+
+/** Iterates through the key overrides that could activate for `keycode` and tries activating each, until it finds one that activates or runs out of candidates. Returns true if the key action for `keycode` should be sent */
 static bool try_activating_override(const uint16_t keycode, const uint8_t layer, const bool key_down, const bool is_mod, const uint8_t active_mods, bool *activated) {
     if (key_overrides == NULL) {
         return true;
     }
 
-    for (uint8_t i = 0;; i++) {
-        const key_override_t *const override = key_overrides[i];
+    key_override_candidates_t candidates;
+    key_override_candidates_init(&candidates, keycode);
 
-        // End of array
-        if (override == NULL) {
-            break;
-        }
+    const layer_state_t layer_mask = (layer_state_t)1 << layer;
+
+    for (const key_override_t *override; (override = key_override_candidates_next(&candidates)) != NULL;) {
 
         // Fast, but not full mods check. Most key presses will not have any mods down, and most overrides will require mods. Hence here we filter overrides that require mods to be down while no mods are down
         if (active_mods == 0 && override->trigger_mods != 0) {
@@ -264,7 +376,7 @@ static bool try_activating_override(const uint16_t keycode, const uint8_t layer,
         }
 
         // Check layer
-        if ((override->layers & (1 << layer)) == 0) {
+        if ((override->layers & layer_mask) == 0) {
             key_override_printf("Not activating override: Not set to activate on pressed layer\n");
             continue;
         }
@@ -397,10 +509,6 @@ void key_override_task(void) {
 }
 
 bool process_key_override(const uint16_t keycode, const keyrecord_t *const record) {
-#ifdef BENCH_KEY_OVERRIDE
-    uint16_t start = timer_read();
-#endif
-
     const bool key_down = record->event.pressed;
     const bool is_mod   = IS_MODIFIER_KEYCODE(keycode);
 
@@ -510,11 +618,5 @@ bool process_key_override(const uint16_t keycode, const keyrecord_t *const recor
         }
     }
 
-#ifdef BENCH_KEY_OVERRIDE
-    uint16_t elapsed = timer_elapsed(start);
-
-    dprintf("Processing key overrides took: %u ms\n", elapsed);
-#endif
-
     return send_key_action;
 }
@@ -224,140 +224,220 @@ void post_process_record_quantum(keyrecord_t *record) {
     post_process_record_kb(keycode, record);
 }
 
-/* Core keycode function, hands off handling to other functions,
-    then processes internal quantum keycodes, and then processes
-    ACTIONs.                                                      */
-bool process_record_quantum(keyrecord_t *record) {
-    uint16_t keycode = get_record_keycode(record, true);
-
-    // This is how you use actions here
-    // if (keycode == QK_LEADER) {
-    //   action_t action;
-    //   action.code = ACTION_DEFAULT_LAYER_SET(0);
-    //   process_action(record, action);
-    //   return false;
-    // }
-
-#if defined(SECURE_ENABLE)
-    if (!preprocess_secure(keycode, record)) {
-        return false;
-    }
-#endif
-
-#ifdef TAP_DANCE_ENABLE
-    if (preprocess_tap_dance(keycode, record)) {
-        // The tap dance might have updated the layer state, therefore the
-        // result of the keycode lookup might change.
-        keycode = get_record_keycode(record, true);
-    }
+/* Feature handlers invoked by process_record_quantum(), in order of precedence.
+ *
+ * Handlers that only act on their own keycodes are given that keycode range, so
+ * that other keycodes skip them entirely. Handlers that need to see every
+ * keycode (to track state, or to interrupt a pending action) cover the whole
+ * range. Processing stops at the first handler that returns false.
+ */
+typedef struct {
+    uint16_t first;
+    uint16_t last;
+    bool (*handler)(uint16_t keycode, keyrecord_t *record);
+#ifdef PROCESS_RECORD_HANDLER_STATS
+    const char *name;
+#endif
+} process_record_handler_t;
+
+#ifdef PROCESS_RECORD_HANDLER_STATS
+#    define PROCESS_RECORD_ALL(handler) \
+        { 0x0000, 0xFFFF, handler, #handler }
+#    define PROCESS_RECORD_RANGE(range, handler) \
+        { range, range##_MAX, handler, #handler }
+#else
+#    define PROCESS_RECORD_ALL(handler) \
+        { 0x0000, 0xFFFF, handler }
+#    define PROCESS_RECORD_RANGE(range, handler) \
+        { range, range##_MAX, handler }
 #endif
 
-#ifdef VELOCIKEY_ENABLE
-    if (velocikey_enabled() && record->event.pressed) {
-        velocikey_accelerate();
-    }
+#ifdef KEY_OVERRIDE_ENABLE
+static bool process_key_override_handler(uint16_t keycode, keyrecord_t *record) {
+    return process_key_override(keycode, record);
+}
 #endif
-
-#ifdef WPM_ENABLE
-    if (record->event.pressed) {
-        update_wpm(keycode);
-    }
+#if defined(RGBLIGHT_ENABLE) || defined(RGB_MATRIX_ENABLE)
+static bool process_rgb_handler(uint16_t keycode, keyrecord_t *record) {
+    return process_rgb(keycode, record);
+}
 #endif
 
-    if (!(
-#if defined(KEY_LOCK_ENABLE)
-            // Must run first to be able to mask key_up events.
-            process_key_lock(&keycode, record) &&
-#endif
+static const process_record_handler_t process_record_handlers[] = {
 #if defined(DYNAMIC_MACRO_ENABLE) && !defined(DYNAMIC_MACRO_USER_CALL)
-            // Must run asap to ensure all keypresses are recorded.
-            process_dynamic_macro(keycode, record) &&
+    // Must run asap to ensure all keypresses are recorded.
+    PROCESS_RECORD_ALL(process_dynamic_macro),
 #endif
 #ifdef REPEAT_KEY_ENABLE
-            process_last_key(keycode, record) && process_repeat_key(keycode, record) &&
+    PROCESS_RECORD_ALL(process_last_key),
+    PROCESS_RECORD_ALL(process_repeat_key),
 #endif
 #if defined(AUDIO_ENABLE) && defined(AUDIO_CLICKY)
-            process_clicky(keycode, record) &&
+    PROCESS_RECORD_ALL(process_clicky),
 #endif
 #ifdef HAPTIC_ENABLE
-            process_haptic(keycode, record) &&
+    PROCESS_RECORD_ALL(process_haptic),
 #endif
 #if defined(VIA_ENABLE)
-            process_record_via(keycode, record) &&
+    PROCESS_RECORD_RANGE(QK_MACRO, process_record_via),
 #endif
 #if defined(POINTING_DEVICE_ENABLE) && defined(POINTING_DEVICE_AUTO_MOUSE_ENABLE)
-            process_auto_mouse(keycode, record) &&
+    PROCESS_RECORD_ALL(process_auto_mouse),
 #endif
-            process_record_kb(keycode, record) &&
+    PROCESS_RECORD_ALL(process_record_kb),
 #if defined(SECURE_ENABLE)
-            process_secure(keycode, record) &&
+    PROCESS_RECORD_ALL(process_secure),
 #endif
 #if defined(SEQUENCER_ENABLE)
-            process_sequencer(keycode, record) &&
+    PROCESS_RECORD_RANGE(QK_SEQUENCER, process_sequencer),
 #endif
 #if defined(MIDI_ENABLE) && defined(MIDI_ADVANCED)
-            process_midi(keycode, record) &&
+    PROCESS_RECORD_RANGE(QK_MIDI, process_midi),
 #endif
 #ifdef AUDIO_ENABLE
-            process_audio(keycode, record) &&
+    PROCESS_RECORD_RANGE(QK_AUDIO, process_audio),
 #endif
 #if defined(BACKLIGHT_ENABLE) || defined(LED_MATRIX_ENABLE)
-            process_backlight(keycode, record) &&
+    PROCESS_RECORD_RANGE(QK_LIGHTING, process_backlight),
 #endif
 #ifdef STENO_ENABLE
-            process_steno(keycode, record) &&
+    PROCESS_RECORD_RANGE(QK_STENO, process_steno),
 #endif
 #if (defined(AUDIO_ENABLE) || (defined(MIDI_ENABLE) && defined(MIDI_BASIC))) && !defined(NO_MUSIC_MODE)
-            process_music(keycode, record) &&
+    // Music mode takes over every key while active
+    PROCESS_RECORD_ALL(process_music),
 #endif
 #ifdef KEY_OVERRIDE_ENABLE
-            process_key_override(keycode, record) &&
+    PROCESS_RECORD_ALL(process_key_override_handler),
 #endif
 #ifdef TAP_DANCE_ENABLE
-            process_tap_dance(keycode, record) &&
+    PROCESS_RECORD_ALL(process_tap_dance),
 #endif
 #ifdef CAPS_WORD_ENABLE
-            process_caps_word(keycode, record) &&
+    PROCESS_RECORD_ALL(process_caps_word),
 #endif
 #if defined(UNICODE_COMMON_ENABLE)
-            process_unicode_common(keycode, record) &&
+#    if defined(UCIS_ENABLE) && !defined(UNICODE_ENABLE) && !defined(UNICODEMAP_ENABLE)
+    // UCIS consumes every key while an input is in progress
+    PROCESS_RECORD_ALL(process_unicode_common),
+#    else
+    PROCESS_RECORD_RANGE(QK_QUANTUM, process_unicode_common),
+    PROCESS_RECORD_RANGE(QK_UNICODE, process_unicode_common),
+#    endif
 #endif
 #ifdef LEADER_ENABLE
-            process_leader(keycode, record) &&
+    PROCESS_RECORD_ALL(process_leader),
 #endif
 #ifdef AUTO_SHIFT_ENABLE
-            process_auto_shift(keycode, record) &&
+    PROCESS_RECORD_ALL(process_auto_shift),
 #endif
 #ifdef DYNAMIC_TAPPING_TERM_ENABLE
-            process_dynamic_tapping_term(keycode, record) &&
+    PROCESS_RECORD_RANGE(QK_QUANTUM, process_dynamic_tapping_term),
 #endif
 #ifdef SPACE_CADET_ENABLE
-            process_space_cadet(keycode, record) &&
+    PROCESS_RECORD_ALL(process_space_cadet),
 #endif
 #ifdef MAGIC_KEYCODE_ENABLE
-            process_magic(keycode, record) &&
+    PROCESS_RECORD_RANGE(QK_MAGIC, process_magic),
 #endif
 #ifdef GRAVE_ESC_ENABLE
-            process_grave_esc(keycode, record) &&
+    PROCESS_RECORD_RANGE(QK_QUANTUM, process_grave_esc),
 #endif
 #if defined(RGBLIGHT_ENABLE) || defined(RGB_MATRIX_ENABLE)
-            process_rgb(keycode, record) &&
+    PROCESS_RECORD_RANGE(QK_LIGHTING, process_rgb_handler),
 #endif
 #ifdef JOYSTICK_ENABLE
-            process_joystick(keycode, record) &&
+    PROCESS_RECORD_RANGE(QK_JOYSTICK, process_joystick),
 #endif
 #ifdef PROGRAMMABLE_BUTTON_ENABLE
-            process_programmable_button(keycode, record) &&
+    PROCESS_RECORD_RANGE(QK_PROGRAMMABLE_BUTTON, process_programmable_button),
 #endif
 #ifdef AUTOCORRECT_ENABLE
-            process_autocorrect(keycode, record) &&
+    PROCESS_RECORD_ALL(process_autocorrect),
 #endif
 #ifdef TRI_LAYER_ENABLE
-            process_tri_layer(keycode, record) &&
+    PROCESS_RECORD_RANGE(QK_QUANTUM, process_tri_layer),
+#endif
+};
+
+#ifdef PROCESS_RECORD_HANDLER_STATS
+uint32_t        process_record_handler_calls = 0;
+static uint32_t process_record_handler_call_counts[ARRAY_SIZE(process_record_handlers)];
+
+uint8_t process_record_handler_count(void) {
+    return ARRAY_SIZE(process_record_handlers);
+}
+
+const char *process_record_handler_name(uint8_t index) {
+    return index < ARRAY_SIZE(process_record_handlers) ? process_record_handlers[index].name : NULL;
+}
+
+uint32_t process_record_handler_call_count(uint8_t index) {
+    return index < ARRAY_SIZE(process_record_handlers) ? process_record_handler_call_counts[index] : 0;
+}
 #endif
-            true)) {
+
+/* Core keycode function, hands off handling to other functions,
+    then processes internal quantum keycodes, and then processes
+    ACTIONs.                                                      */
+bool process_record_quantum(keyrecord_t *record) {
+    uint16_t keycode = get_record_keycode(record, true);
+
+    // This is how you use actions here
+    // if (keycode == QK_LEADER) {
+    //   action_t action;
+    //   action.code = ACTION_DEFAULT_LAYER_SET(0);
+    //   process_action(record, action);
+    //   return false;
+    // }
+
+#if defined(SECURE_ENABLE)
+    if (!preprocess_secure(keycode, record)) {
         return false;
     }
+#endif
+
+#ifdef TAP_DANCE_ENABLE
+    if (preprocess_tap_dance(keycode, record)) {
+        // The tap dance might have updated the layer state, therefore the
+        // result of the keycode lookup might change.
+        keycode = get_record_keycode(record, true);
+    }
+#endif
+
+#ifdef VELOCIKEY_ENABLE
+    if (velocikey_enabled() && record->event.pressed) {
+        velocikey_accelerate();
+    }
+#endif
+
+#ifdef WPM_ENABLE
+    if (record->event.pressed) {
+        update_wpm(keycode);
+    }
+#endif
+
+#if defined(KEY_LOCK_ENABLE)
+    // Must run first to be able to mask key_up events.
+    if (!process_key_lock(&keycode, record)) {
+        return false;
+    }
+#endif
+
+    // Run the feature handlers, in order, skipping any whose keycode range doesn't cover this keycode
+    for (uint8_t i = 0; i < ARRAY_SIZE(process_record_handlers); ++i) {
+        const process_record_handler_t *entry = &process_record_handlers[i];
+        if (keycode < entry->first || keycode > entry->last) {
+            continue;
+        }
+#ifdef PROCESS_RECORD_HANDLER_STATS
+        ++process_record_handler_calls;
+        ++process_record_handler_call_counts[i];
+#endif
+        if (!entry->handler(keycode, record)) {
+            return false;
+        }
+    }
 
     if (record->event.pressed) {
         switch (keycode) {
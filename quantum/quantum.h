@@ -275,6 +275,15 @@ bool     process_record_user(uint16_t keycode, keyrecord_t *record);
 void     post_process_record_kb(uint16_t keycode, keyrecord_t *record);
 void     post_process_record_user(uint16_t keycode, keyrecord_t *record);
 
+#ifdef PROCESS_RECORD_HANDLER_STATS
+// Number of feature handlers invoked by process_record_quantum(), and the number of handlers it dispatches to
+extern uint32_t process_record_handler_calls;
+uint8_t         process_record_handler_count(void);
+// Name and number of invocations of each handler, in dispatch order
+const char *process_record_handler_name(uint8_t index);
+uint32_t    process_record_handler_call_count(uint8_t index);
+#endif
+
 void reset_keyboard(void);
 void soft_reset_keyboard(void);
 
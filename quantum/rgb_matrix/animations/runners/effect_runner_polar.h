@@ -0,0 +1,15 @@
+#pragma once
+
+typedef HSV (*polar_f)(HSV hsv, uint8_t angle, uint8_t dist, uint8_t time);
+
+LED_RENDER_RUNNER bool effect_runner_polar(effect_params_t* params, polar_f effect_func) {
+    RGB_MATRIX_USE_LIMITS(led_min, led_max);
+
+    uint8_t time = scale16by8(g_rgb_timer, rgb_matrix_config.speed / 2);
+    for (uint8_t i = led_min; i < led_max; i++) {
+        RGB_MATRIX_TEST_LED_FLAGS();
+        led_polar_t polar = rgb_matrix_polar(i);
+        rgb_matrix_render_hsv(i, effect_func(rgb_matrix_config.hsv, polar.angle, polar.dist, time));
+    }
+    return rgb_matrix_check_finished_leds(led_max);
+}
@@ -4,10 +4,12 @@
 
 typedef HSV (*reactive_f)(HSV hsv, uint16_t offset);
 
-bool effect_runner_reactive(effect_params_t* params, reactive_f effect_func) {
+LED_RENDER_RUNNER bool effect_runner_reactive(effect_params_t* params, reactive_f effect_func) {
     RGB_MATRIX_USE_LIMITS(led_min, led_max);
 
     uint16_t max_tick = 65535 / qadd8(rgb_matrix_config.speed, 1);
+    // LEDs without a recent hit all show the same color, only render them when they have faded out or been written over
+    rgb_matrix_sparse_begin(params, effect_func(rgb_matrix_config.hsv, scale16by8(max_tick, qadd8(rgb_matrix_config.speed, 1))));
     for (uint8_t i = led_min; i < led_max; i++) {
         RGB_MATRIX_TEST_LED_FLAGS();
         uint16_t tick = max_tick;
@@ -18,10 +20,11 @@ bool effect_runner_reactive(effect_params_t* params, reactive_f effect_func) {
                 break;
             }
         }
+        if (tick == max_tick && !rgb_matrix_is_dirty(i)) continue;
+        rgb_matrix_set_dirty(i, tick != max_tick);
 
         uint16_t offset = scale16by8(tick, qadd8(rgb_matrix_config.speed, 1));
-        RGB      rgb    = rgb_matrix_hsv_to_rgb(effect_func(rgb_matrix_config.hsv, offset));
-        rgb_matrix_set_color(i, rgb.r, rgb.g, rgb.b);
+        rgb_matrix_render_hsv(i, effect_func(rgb_matrix_config.hsv, offset));
     }
     return rgb_matrix_check_finished_leds(led_max);
 }
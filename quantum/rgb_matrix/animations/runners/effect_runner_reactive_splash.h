@@ -4,12 +4,49 @@
 
 typedef HSV (*reactive_splash_f)(HSV hsv, int16_t dx, int16_t dy, uint8_t dist, uint16_t tick);
 
-bool effect_runner_reactive_splash(uint8_t start, effect_params_t* params, reactive_splash_f effect_func) {
+// Range of distances from a hit that it can light up, `tick` after the hit. LEDs outside of it are left dark.
+typedef struct {
+    uint16_t min;
+    uint16_t max;
+} reactive_reach_t;
+
+typedef reactive_reach_t (*reactive_reach_f)(uint16_t tick);
+
+// Only renders the LEDs within reach of a hit, or dirty, when given a `reach_func`
+LED_RENDER_RUNNER bool effect_runner_reactive_splash_sparse(uint8_t start, effect_params_t* params, reactive_splash_f effect_func, reactive_reach_f reach_func) {
     RGB_MATRIX_USE_LIMITS(led_min, led_max);
 
-    uint8_t count = g_last_hit_tracker.count;
+    uint8_t  count = g_last_hit_tracker.count;
+    uint16_t reach_min[LED_HITS_TO_REMEMBER]; // Squared, to compare with the squared distance
+    uint16_t reach_max[LED_HITS_TO_REMEMBER];
+    if (reach_func) {
+        for (uint8_t j = start; j < count; j++) {
+            reactive_reach_t reach = reach_func(scale16by8(g_last_hit_tracker.tick[j], qadd8(rgb_matrix_config.speed, 1)));
+            if (reach.min > reach.max || reach.min > UINT8_MAX) {
+                reach_min[j] = 1;
+                reach_max[j] = 0;
+            } else {
+                reach_min[j] = reach.min * reach.min;
+                reach_max[j] = reach.max >= UINT8_MAX ? UINT16_MAX : (reach.max + 1) * (reach.max + 1) - 1;
+            }
+        }
+        rgb_matrix_sparse_begin(params, (HSV){0, 0, 0});
+    }
+
     for (uint8_t i = led_min; i < led_max; i++) {
         RGB_MATRIX_TEST_LED_FLAGS();
+        if (reach_func) {
+            bool lit = false;
+            for (uint8_t j = start; j < count && !lit; j++) {
+                int16_t  dx     = g_led_config.point[i].x - g_last_hit_tracker.x[j];
+                int16_t  dy     = g_led_config.point[i].y - g_last_hit_tracker.y[j];
+                uint16_t square = dx * dx + dy * dy;
+                lit             = square >= reach_min[j] && square <= reach_max[j];
+            }
+            if (!lit && !rgb_matrix_is_dirty(i)) continue;
+            rgb_matrix_set_dirty(i, lit);
+        }
+
         HSV hsv = rgb_matrix_config.hsv;
         hsv.v   = 0;
         for (uint8_t j = start; j < count; j++) {
@@ -19,11 +56,14 @@ bool effect_runner_reactive_splash(uint8_t start, effect_params_t* params, react
             uint16_t tick = scale16by8(g_last_hit_tracker.tick[j], qadd8(rgb_matrix_config.speed, 1));
             hsv           = effect_func(hsv, dx, dy, dist, tick);
         }
-        hsv.v   = scale8(hsv.v, rgb_matrix_config.hsv.v);
-        RGB rgb = rgb_matrix_hsv_to_rgb(hsv);
-        rgb_matrix_set_color(i, rgb.r, rgb.g, rgb.b);
+        hsv.v = scale8(hsv.v, rgb_matrix_config.hsv.v);
+        rgb_matrix_render_hsv(i, hsv);
     }
     return rgb_matrix_check_finished_leds(led_max);
 }
 
+LED_RENDER_RUNNER bool effect_runner_reactive_splash(uint8_t start, effect_params_t* params, reactive_splash_f effect_func) {
+    return effect_runner_reactive_splash_sparse(start, params, effect_func, NULL);
+}
+
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
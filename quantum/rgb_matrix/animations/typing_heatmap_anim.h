@@ -16,33 +16,141 @@ RGB_MATRIX_EFFECT(TYPING_HEATMAP)
 #        ifndef RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT
 #            define RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT 16
 #        endif
+#        ifndef RGB_MATRIX_TYPING_HEATMAP_NEIGHBOURS
+#            define RGB_MATRIX_TYPING_HEATMAP_NEIGHBOURS 0
+#        endif
+
+// The key shown on each LED, the last one in the matrix when several share it, row UINT8_MAX for none.
+typedef struct {
+    uint8_t row;
+    uint8_t col;
+} heatmap_key_t;
+
+static heatmap_key_t heatmap_keys[RGB_MATRIX_LED_COUNT];
+static bool          heatmap_keys_ready;
+
+// The heat of each key is kept in g_rgb_frame_buffer as it was at its stamp, and
+// drops by one for every decrease step since, when it is next read.
+static uint8_t heatmap_stamp[MATRIX_ROWS][MATRIX_COLS];
+static uint8_t heatmap_step;
+
+static uint8_t heatmap_read(uint8_t row, uint8_t col) {
+    uint8_t heat                 = qsub8(g_rgb_frame_buffer[row][col], (uint8_t)(heatmap_step - heatmap_stamp[row][col]));
+    g_rgb_frame_buffer[row][col] = heat;
+    heatmap_stamp[row][col]      = heatmap_step;
+    return heat;
+}
+
+static void heatmap_add(uint8_t row, uint8_t col, uint8_t amount) {
+    g_rgb_frame_buffer[row][col] = qadd8(heatmap_read(row, col), amount);
+}
+
+#        ifndef RGB_MATRIX_TYPING_HEATMAP_SLIM
+// Heat a press of the key at `from` spreads to the one at `to`, 0 when out of reach.
+static uint8_t heatmap_spread(led_point_t from, led_point_t to) {
+    int16_t  dx     = from.x - to.x;
+    int16_t  dy     = from.y - to.y;
+    uint16_t square = dx * dx + dy * dy;
+    // Only take the root of the keys within reach
+    if (square >= (RGB_MATRIX_TYPING_HEATMAP_SPREAD + 1) * (RGB_MATRIX_TYPING_HEATMAP_SPREAD + 1)) {
+        return 0;
+    }
+    uint8_t amount = qsub8(RGB_MATRIX_TYPING_HEATMAP_SPREAD, sqrt16(square));
+    if (amount > RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT) {
+        amount = RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT;
+    }
+    return amount;
+}
+
+#            if RGB_MATRIX_TYPING_HEATMAP_NEIGHBOURS > 0
+// The keys within reach of each key and the heat they get, built with heatmap_keys.
+typedef struct {
+    uint8_t led;
+    uint8_t amount;
+} heatmap_neighbour_t;
+
+// Count UINT8_MAX for the keys whose neighbours did not fit, which are searched for on each press instead.
+typedef struct {
+    uint16_t first;
+    uint8_t  count;
+} heatmap_neighbours_t;
+
+static heatmap_neighbour_t  heatmap_neighbour_pool[RGB_MATRIX_TYPING_HEATMAP_NEIGHBOURS];
+static heatmap_neighbours_t heatmap_neighbours[RGB_MATRIX_LED_COUNT];
+
+static void heatmap_neighbours_init(void) {
+    uint16_t used = 0;
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        heatmap_neighbours[i] = (heatmap_neighbours_t){.first = used, .count = 0};
+        if (heatmap_keys[i].row == UINT8_MAX) continue;
+        for (uint8_t j = 0; j < RGB_MATRIX_LED_COUNT; j++) {
+            if (j == i || heatmap_keys[j].row == UINT8_MAX) continue;
+            uint8_t amount = heatmap_spread(g_led_config.point[i], g_led_config.point[j]);
+            if (amount == 0) continue;
+            if (used == RGB_MATRIX_TYPING_HEATMAP_NEIGHBOURS) {
+                used                        = heatmap_neighbours[i].first;
+                heatmap_neighbours[i].count = UINT8_MAX;
+                break;
+            }
+            heatmap_neighbour_pool[used++] = (heatmap_neighbour_t){.led = j, .amount = amount};
+            heatmap_neighbours[i].count++;
+        }
+    }
+}
+#            endif
+#        endif
+
+static void heatmap_keys_init(void) {
+    if (heatmap_keys_ready) return;
+    heatmap_keys_ready = true;
+
+    memset(heatmap_keys, UINT8_MAX, sizeof heatmap_keys);
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            uint8_t led = g_led_config.matrix_co[row][col];
+            if (led < RGB_MATRIX_LED_COUNT) {
+                heatmap_keys[led] = (heatmap_key_t){.row = row, .col = col};
+            }
+        }
+    }
+#        if !defined(RGB_MATRIX_TYPING_HEATMAP_SLIM) && RGB_MATRIX_TYPING_HEATMAP_NEIGHBOURS > 0
+    heatmap_neighbours_init();
+#        endif
+}
+
 void process_rgb_matrix_typing_heatmap(uint8_t row, uint8_t col) {
 #        ifdef RGB_MATRIX_TYPING_HEATMAP_SLIM
     // Limit effect to pressed keys
-    g_rgb_frame_buffer[row][col] = qadd8(g_rgb_frame_buffer[row][col], RGB_MATRIX_TYPING_HEATMAP_INCREASE_STEP);
+    heatmap_add(row, col, RGB_MATRIX_TYPING_HEATMAP_INCREASE_STEP);
 #        else
-    if (g_led_config.matrix_co[row][col] == NO_LED) { // skip as pressed key doesn't have an led position
+    uint8_t led = g_led_config.matrix_co[row][col];
+    if (led == NO_LED) { // skip as pressed key doesn't have an led position
         return;
     }
-    for (uint8_t i_row = 0; i_row < MATRIX_ROWS; i_row++) {
-        for (uint8_t i_col = 0; i_col < MATRIX_COLS; i_col++) {
-            if (g_led_config.matrix_co[i_row][i_col] == NO_LED) { // skip as target key doesn't have an led position
-                continue;
-            }
-            if (i_row == row && i_col == col) {
-                g_rgb_frame_buffer[row][col] = qadd8(g_rgb_frame_buffer[row][col], RGB_MATRIX_TYPING_HEATMAP_INCREASE_STEP);
-            } else {
-#            define LED_DISTANCE(led_a, led_b) sqrt16(((int16_t)(led_a.x - led_b.x) * (int16_t)(led_a.x - led_b.x)) + ((int16_t)(led_a.y - led_b.y) * (int16_t)(led_a.y - led_b.y)))
-                uint8_t distance = LED_DISTANCE(g_led_config.point[g_led_config.matrix_co[row][col]], g_led_config.point[g_led_config.matrix_co[i_row][i_col]]);
-#            undef LED_DISTANCE
-                if (distance <= RGB_MATRIX_TYPING_HEATMAP_SPREAD) {
-                    uint8_t amount = qsub8(RGB_MATRIX_TYPING_HEATMAP_SPREAD, distance);
-                    if (amount > RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT) {
-                        amount = RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT;
-                    }
-                    g_rgb_frame_buffer[i_row][i_col] = qadd8(g_rgb_frame_buffer[i_row][i_col], amount);
-                }
-            }
+    heatmap_keys_init();
+
+    heatmap_add(row, col, RGB_MATRIX_TYPING_HEATMAP_INCREASE_STEP);
+    // Another key shown on the same LED is as close as it gets
+    heatmap_key_t shown = heatmap_keys[led];
+    if (shown.row != row || shown.col != col) {
+        heatmap_add(shown.row, shown.col, heatmap_spread(g_led_config.point[led], g_led_config.point[led]));
+    }
+
+#            if RGB_MATRIX_TYPING_HEATMAP_NEIGHBOURS > 0
+    heatmap_neighbours_t neighbours = heatmap_neighbours[led];
+    if (neighbours.count != UINT8_MAX) {
+        for (uint16_t i = neighbours.first; i < neighbours.first + neighbours.count; i++) {
+            heatmap_key_t key = heatmap_keys[heatmap_neighbour_pool[i].led];
+            heatmap_add(key.row, key.col, heatmap_neighbour_pool[i].amount);
+        }
+        return;
+    }
+#            endif
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        if (i == led || heatmap_keys[i].row == UINT8_MAX) continue;
+        uint8_t amount = heatmap_spread(g_led_config.point[led], g_led_config.point[i]);
+        if (amount) {
+            heatmap_add(heatmap_keys[i].row, heatmap_keys[i].col, amount);
         }
     }
 #        endif
@@ -59,7 +167,10 @@ bool TYPING_HEATMAP(effect_params_t* params) {
     if (params->init) {
         rgb_matrix_set_color_all(0, 0, 0);
         memset(g_rgb_frame_buffer, 0, sizeof g_rgb_frame_buffer);
+        heatmap_keys_init();
     }
+    // Keys that have cooled down are left dark, only render them once they are written over
+    rgb_matrix_sparse_begin(params, (HSV){0, 0, 0});
 
     // The heatmap animation might run in several iterations depending on
     // `RGB_MATRIX_LED_PROCESS_LIMIT`, therefore we only want to update the
@@ -73,27 +184,27 @@ bool TYPING_HEATMAP(effect_params_t* params) {
         }
     }
 
-    // Render heatmap & decrease
-    uint8_t count = 0;
-    for (uint8_t row = 0; row < MATRIX_ROWS && count < RGB_MATRIX_LED_PROCESS_LIMIT; row++) {
-        for (uint8_t col = 0; col < MATRIX_COLS && RGB_MATRIX_LED_PROCESS_LIMIT; col++) {
-            if (g_led_config.matrix_co[row][col] >= led_min && g_led_config.matrix_co[row][col] < led_max) {
-                count++;
-                uint8_t val = g_rgb_frame_buffer[row][col];
-                if (!HAS_ANY_FLAGS(g_led_config.flags[g_led_config.matrix_co[row][col]], params->flags)) continue;
-
-                HSV hsv = {170 - qsub8(val, 85), rgb_matrix_config.hsv.s, scale8((qadd8(170, val) - 170) * 3, rgb_matrix_config.hsv.v)};
-                RGB rgb = rgb_matrix_hsv_to_rgb(hsv);
-                rgb_matrix_set_color(g_led_config.matrix_co[row][col], rgb.r, rgb.g, rgb.b);
-
-                if (decrease_heatmap_values) {
-                    g_rgb_frame_buffer[row][col] = qsub8(val, 1);
-                }
-            }
-        }
+    // Render heatmap, the keys only cool down once the frame is done
+    for (uint8_t i = led_min; i < led_max; i++) {
+        heatmap_key_t key = heatmap_keys[i];
+        if (key.row == UINT8_MAX) continue;
+        if (g_rgb_frame_buffer[key.row][key.col] == 0 && !rgb_matrix_is_dirty(i)) continue;
+        uint8_t val = heatmap_read(key.row, key.col);
+        RGB_MATRIX_TEST_LED_FLAGS();
+
+        HSV hsv = {170 - qsub8(val, 85), rgb_matrix_config.hsv.s, scale8((qadd8(170, val) - 170) * 3, rgb_matrix_config.hsv.v)};
+        RGB rgb = rgb_matrix_hsv_to_rgb(hsv);
+        rgb_matrix_set_color(i, rgb.r, rgb.g, rgb.b);
+        rgb_matrix_set_dirty(i, val != 0);
     }
 
-    return rgb_matrix_check_finished_leds(led_max);
+    if (rgb_matrix_check_finished_leds(led_max)) {
+        return true;
+    }
+    if (decrease_heatmap_values) {
+        heatmap_step++;
+    }
+    return false;
 }
 
 #    endif // RGB_MATRIX_CUSTOM_EFFECT_IMPLS
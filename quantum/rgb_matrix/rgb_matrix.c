@@ -17,6 +17,7 @@
  */
 
 #include "rgb_matrix.h"
+#include "led_render.h"
 #include "progmem.h"
 #include "eeprom.h"
 #include <string.h>
@@ -34,6 +35,47 @@ __attribute__((weak)) RGB rgb_matrix_hsv_to_rgb(HSV hsv) {
     return hsv_to_rgb(hsv);
 }
 
+// Straight to the driver, the sparse effect runners keep track of what they render themselves
+static inline void rgb_matrix_render_hsv(uint8_t index, HSV hsv) {
+    RGB rgb = rgb_matrix_hsv_to_rgb(hsv);
+    rgb_matrix_driver.set_color(index, rgb.r, rgb.g, rgb.b);
+}
+
+#ifdef LED_RENDER_POLAR_TABLE
+static led_polar_t rgb_matrix_polar_table[RGB_MATRIX_LED_COUNT];
+#endif
+
+static inline led_polar_t rgb_matrix_polar(uint8_t index) {
+#ifdef LED_RENDER_POLAR_TABLE
+    return rgb_matrix_polar_table[index];
+#else
+    return led_render_polar(g_led_config.point[index], k_rgb_matrix_center);
+#endif
+}
+
+static uint8_t rgb_matrix_dirty[LED_RENDER_DIRTY_SIZE(RGB_MATRIX_LED_COUNT)];
+static HSV     rgb_matrix_idle;
+
+static inline bool rgb_matrix_is_dirty(uint8_t index) {
+    return led_render_is_dirty(rgb_matrix_dirty, index);
+}
+
+static inline void rgb_matrix_set_dirty(uint8_t index, bool dirty) {
+    led_render_set_dirty(rgb_matrix_dirty, index, dirty);
+}
+
+static inline void rgb_matrix_set_dirty_all(void) {
+    memset(rgb_matrix_dirty, 0xFF, sizeof(rgb_matrix_dirty));
+}
+
+// Called by the sparse effects on each span, with the color they leave the LEDs they don't reach at
+static inline void rgb_matrix_sparse_begin(effect_params_t *params, HSV idle) {
+    if (params->init || idle.h != rgb_matrix_idle.h || idle.s != rgb_matrix_idle.s || idle.v != rgb_matrix_idle.v) {
+        rgb_matrix_idle = idle;
+        rgb_matrix_set_dirty_all();
+    }
+}
+
 // Generic effect runners
 #include "rgb_matrix_runners.inc"
 
@@ -116,11 +158,8 @@ last_hit_t g_last_hit_tracker;
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
 
 // internals
-static bool            suspend_state     = false;
-static uint8_t         rgb_last_enable   = UINT8_MAX;
-static uint8_t         rgb_last_effect   = UINT8_MAX;
-static effect_params_t rgb_effect_params = {0, LED_FLAG_ALL, false};
-static rgb_task_states rgb_task_state    = SYNCING;
+static bool         suspend_state     = false;
+static led_render_t rgb_matrix_render = LED_RENDER_INIT;
 #if RGB_MATRIX_TIMEOUT > 0
 static uint32_t rgb_anykey_timer;
 #endif // RGB_MATRIX_TIMEOUT > 0
@@ -193,6 +232,9 @@ void rgb_matrix_update_pwm_buffers(void) {
 
 void rgb_matrix_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
     rgb_matrix_driver.set_color(index, red, green, blue);
+    if (index >= 0 && index < RGB_MATRIX_LED_COUNT) {
+        rgb_matrix_set_dirty(index, true);
+    }
 }
 
 void rgb_matrix_set_color_all(uint8_t red, uint8_t green, uint8_t blue) {
@@ -201,6 +243,7 @@ void rgb_matrix_set_color_all(uint8_t red, uint8_t green, uint8_t blue) {
         rgb_matrix_set_color(i, red, green, blue);
 #else
     rgb_matrix_driver.set_color_all(red, green, blue);
+    rgb_matrix_set_dirty_all();
 #endif
 }
 
@@ -316,55 +359,39 @@ static void rgb_task_timers(void) {
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
 }
 
-static void rgb_task_sync(void) {
+static bool rgb_task_sync(void) {
     eeconfig_flush_rgb_matrix(false);
-    // next task
-    if (sync_timer_elapsed32(g_rgb_timer) >= RGB_MATRIX_LED_FLUSH_LIMIT) rgb_task_state = STARTING;
+    return sync_timer_elapsed32(g_rgb_timer) >= RGB_MATRIX_LED_FLUSH_LIMIT;
 }
 
 static void rgb_task_start(void) {
-    // reset iter
-    rgb_effect_params.iter = 0;
-
-    // update double buffers
     g_rgb_timer = rgb_timer_buffer;
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
     g_last_hit_tracker = last_hit_buffer;
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
-
-    // next task
-    rgb_task_state = RENDERING;
 }
 
-static void rgb_task_render(uint8_t effect) {
-    bool rendering         = false;
-    rgb_effect_params.init = (effect != rgb_last_effect) || (rgb_matrix_config.enable != rgb_last_enable);
-    if (rgb_effect_params.flags != rgb_matrix_config.flags) {
-        rgb_effect_params.flags = rgb_matrix_config.flags;
-        rgb_matrix_set_color_all(0, 0, 0);
-    }
+static void rgb_task_clear(void) {
+    rgb_matrix_set_color_all(0, 0, 0);
+}
 
-    // each effect can opt to do calculations
-    // and/or request PWM buffer updates.
+static bool rgb_task_render(uint8_t effect, effect_params_t *params) {
     switch (effect) {
         case RGB_MATRIX_NONE:
-            rendering = rgb_matrix_none(&rgb_effect_params);
-            break;
+            return rgb_matrix_none(params);
 
 // ---------------------------------------------
 // -----Begin rgb effect switch case macros-----
-#define RGB_MATRIX_EFFECT(name, ...)          \
-    case RGB_MATRIX_##name:                   \
-        rendering = name(&rgb_effect_params); \
-        break;
+#define RGB_MATRIX_EFFECT(name, ...) \
+    case RGB_MATRIX_##name:          \
+        return name(params);
 #include "rgb_matrix_effects.inc"
 #undef RGB_MATRIX_EFFECT
 
 #if defined(RGB_MATRIX_CUSTOM_KB) || defined(RGB_MATRIX_CUSTOM_USER)
-#    define RGB_MATRIX_EFFECT(name, ...)          \
-        case RGB_MATRIX_CUSTOM_##name:            \
-            rendering = name(&rgb_effect_params); \
-            break;
+#    define RGB_MATRIX_EFFECT(name, ...) \
+        case RGB_MATRIX_CUSTOM_##name:   \
+            return name(params);
 #    ifdef RGB_MATRIX_CUSTOM_KB
 #        include "rgb_matrix_kb.inc"
 #    endif
@@ -377,37 +404,27 @@ static void rgb_task_render(uint8_t effect) {
             // ---------------------------------------------
 
         // Factory default magic value
-        case UINT8_MAX: {
+        case UINT8_MAX:
             rgb_matrix_test();
-            rgb_task_state = FLUSHING;
-        }
-            return;
-    }
-
-    rgb_effect_params.iter++;
-
-    // next task
-    if (!rendering) {
-        rgb_task_state = FLUSHING;
-        if (!rgb_effect_params.init && effect == RGB_MATRIX_NONE) {
-            // We only need to flush once if we are RGB_MATRIX_NONE
-            rgb_task_state = SYNCING;
-        }
+            return false;
     }
+    return false;
 }
 
-static void rgb_task_flush(uint8_t effect) {
-    // update last trackers after the first full render so we can init over several frames
-    rgb_last_effect = effect;
-    rgb_last_enable = rgb_matrix_config.enable;
-
-    // update pwm buffers
-    rgb_matrix_update_pwm_buffers();
-
-    // next task
-    rgb_task_state = SYNCING;
+static void rgb_task_indicators(effect_params_t *params) {
+    rgb_matrix_indicators();
+    rgb_matrix_indicators_advanced(params);
 }
 
+static const led_render_hooks_t rgb_matrix_hooks = {
+    .sync       = rgb_task_sync,
+    .start      = rgb_task_start,
+    .clear      = rgb_task_clear,
+    .render     = rgb_task_render,
+    .indicators = rgb_task_indicators,
+    .flush      = rgb_matrix_update_pwm_buffers,
+};
+
 void rgb_matrix_task(void) {
     rgb_task_timers();
 
@@ -421,24 +438,7 @@ void rgb_matrix_task(void) {
 
     uint8_t effect = suspend_backlight || !rgb_matrix_config.enable ? 0 : rgb_matrix_config.mode;
 
-    switch (rgb_task_state) {
-        case STARTING:
-            rgb_task_start();
-            break;
-        case RENDERING:
-            rgb_task_render(effect);
-            if (effect) {
-                rgb_matrix_indicators();
-                rgb_matrix_indicators_advanced(&rgb_effect_params);
-            }
-            break;
-        case FLUSHING:
-            rgb_task_flush(effect);
-            break;
-        case SYNCING:
-            rgb_task_sync();
-            break;
-    }
+    led_render_task(&rgb_matrix_render, &rgb_matrix_hooks, effect, rgb_matrix_config.enable, rgb_matrix_config.flags);
 }
 
 void rgb_matrix_indicators(void) {
@@ -455,9 +455,9 @@ __attribute__((weak)) bool rgb_matrix_indicators_user(void) {
 
 void rgb_matrix_indicators_advanced(effect_params_t *params) {
     /* special handling is needed for "params->iter", since it's already been incremented.
-     * Could move the invocations to rgb_task_render, but then it's missing a few checks
+     * Could move the invocations to led_render_span, but then it's missing a few checks
      * and not sure which would be better. Otherwise, this should be called from
-     * rgb_task_render, right before the iter++ line.
+     * led_render_span, right before the iter++ line.
      */
     RGB_MATRIX_USE_LIMITS_ITER(min, max, params->iter - 1);
     rgb_matrix_indicators_advanced_kb(min, max);
@@ -474,6 +474,10 @@ __attribute__((weak)) bool rgb_matrix_indicators_advanced_user(uint8_t led_min,
 void rgb_matrix_init(void) {
     rgb_matrix_driver.init();
 
+#ifdef LED_RENDER_POLAR_TABLE
+    led_render_polar_init(rgb_matrix_polar_table, g_led_config.point, RGB_MATRIX_LED_COUNT, k_rgb_matrix_center);
+#endif
+
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
     g_last_hit_tracker.count = 0;
     for (uint8_t i = 0; i < LED_HITS_TO_REMEMBER; ++i) {
@@ -503,8 +507,8 @@ void rgb_matrix_init(void) {
 void rgb_matrix_set_suspend_state(bool state) {
 #ifdef RGB_DISABLE_WHEN_USB_SUSPENDED
     if (state && !suspend_state) { // only run if turning off, and only once
-        rgb_task_render(0);        // turn off all LEDs when suspending
-        rgb_task_flush(0);         // and actually flash led state to LEDs
+        // turn off all LEDs when suspending, and actually flash led state to LEDs
+        led_render_now(&rgb_matrix_render, &rgb_matrix_hooks, 0, rgb_matrix_config.enable, rgb_matrix_config.flags);
     }
     suspend_state = state;
 #endif
@@ -516,7 +520,7 @@ bool rgb_matrix_get_suspend_state(void) {
 
 void rgb_matrix_toggle_eeprom_helper(bool write_to_eeprom) {
     rgb_matrix_config.enable ^= 1;
-    rgb_task_state = STARTING;
+    led_render_restart(&rgb_matrix_render);
     eeconfig_flag_rgb_matrix(write_to_eeprom);
     dprintf("rgb matrix toggle [%s]: rgb_matrix_config.enable = %u\n", (write_to_eeprom) ? "EEPROM" : "NOEEPROM", rgb_matrix_config.enable);
 }
@@ -533,7 +537,7 @@ void rgb_matrix_enable(void) {
 }
 
 void rgb_matrix_enable_noeeprom(void) {
-    if (!rgb_matrix_config.enable) rgb_task_state = STARTING;
+    if (!rgb_matrix_config.enable) led_render_restart(&rgb_matrix_render);
     rgb_matrix_config.enable = 1;
 }
 
@@ -543,7 +547,7 @@ void rgb_matrix_disable(void) {
 }
 
 void rgb_matrix_disable_noeeprom(void) {
-    if (rgb_matrix_config.enable) rgb_task_state = STARTING;
+    if (rgb_matrix_config.enable) led_render_restart(&rgb_matrix_render);
     rgb_matrix_config.enable = 0;
 }
 
@@ -562,7 +566,7 @@ void rgb_matrix_mode_eeprom_helper(uint8_t mode, bool write_to_eeprom) {
     } else {
         rgb_matrix_config.mode = mode;
     }
-    rgb_task_state = STARTING;
+    led_render_restart(&rgb_matrix_render);
     eeconfig_flag_rgb_matrix(write_to_eeprom);
     dprintf("rgb matrix mode [%s]: %u\n", (write_to_eeprom) ? "EEPROM" : "NOEEPROM", rgb_matrix_config.mode);
 }
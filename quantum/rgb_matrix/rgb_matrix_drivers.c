@@ -426,11 +426,16 @@ const rgb_matrix_driver_t rgb_matrix_driver = {
 
 // LED color buffer
 LED_TYPE rgb_matrix_ws2812_array[RGB_MATRIX_LED_COUNT];
+// Whether the buffer was written to since the last flush, the reactive effects leave it alone while idle
+static bool ws2812_dirty = false;
 
 static void init(void) {}
 
 static void flush(void) {
-    ws2812_setleds(rgb_matrix_ws2812_array, RGB_MATRIX_LED_COUNT);
+    if (ws2812_dirty) {
+        ws2812_setleds(rgb_matrix_ws2812_array, RGB_MATRIX_LED_COUNT);
+        ws2812_dirty = false;
+    }
 }
 
 // Set an led in the buffer to a color
@@ -454,6 +459,7 @@ static inline void setled(int i, uint8_t r, uint8_t g, uint8_t b) {
 #    ifdef RGBW
     convert_rgb_to_rgbw(&rgb_matrix_ws2812_array[i]);
 #    endif
+    ws2812_dirty = true;
 }
 
 static void setled_all(uint8_t r, uint8_t g, uint8_t b) {
@@ -56,7 +56,12 @@ void slave_rpc_exec_callback(uint8_t initiator2target_buffer_size, const void *i
 // Helpers
 
 static bool transaction_handler_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[], const char *prefix, bool (*handler)(matrix_row_t master_matrix[], matrix_row_t slave_matrix[])) {
+#ifdef SPLIT_TRANSPORT_THREAD
+    // The result only changes once the transport thread finished its next batch, retrying right away won't help
+    int num_retries = 1;
+#else
     int num_retries = is_transport_connected() ? 10 : 1;
+#endif
     for (int iter = 1; iter <= num_retries; ++iter) {
         if (iter > 1) {
             for (int i = 0; i < iter * iter; ++i) {
@@ -102,19 +107,58 @@ static bool transaction_handler_master(matrix_row_t master_matrix[], matrix_row_
         split_shared_memory_unlock();                         \
     } while (0)
 
-inline static bool read_if_checksum_mismatch(int8_t trans_id_checksum, int8_t trans_id_retrieve, uint32_t *last_update, void *destination, const void *equiv_shmem, size_t length) {
+/* With SPLIT_TRANSPORT_THREAD the transport thread copies batch results into
+ * split_shmem while the master handlers run, so they only look at it under the
+ * lock. Without the transport thread the lock is uncontended, but still taken:
+ * on ChibiOS it is a real mutex either way. */
+inline static void split_shmem_read(void *destination, const void *equiv_shmem, size_t length) {
+    split_shared_memory_lock();
+    memcpy(destination, equiv_shmem, length);
+    split_shared_memory_unlock();
+}
+
+inline static bool split_shmem_differs(const void *source, const void *equiv_shmem, size_t length) {
+    split_shared_memory_lock();
+    bool differs = memcmp(source, equiv_shmem, length) != 0;
+    split_shared_memory_unlock();
+    return differs;
+}
+
+inline static uint8_t split_shmem_crc8(const void *equiv_shmem, size_t length) {
+    split_shared_memory_lock();
+    uint8_t checksum = crc8(equiv_shmem, length);
+    split_shared_memory_unlock();
+    return checksum;
+}
+
+typedef enum {
+    SPLIT_READ_FAILED,  // The transport failed, or the data did not match its checksum
+    SPLIT_READ_PENDING, // The data has yet to catch up with its checksum, it is read again next time
+    SPLIT_READ_DONE,    // `destination` holds the current data
+} split_read_result_t;
+
+inline static split_read_result_t read_if_checksum_mismatch(int8_t trans_id_checksum, int8_t trans_id_retrieve, uint32_t *last_update, void *destination, const void *equiv_shmem, size_t length) {
     uint8_t curr_checksum;
-    bool    okay = transport_read(trans_id_checksum, &curr_checksum, sizeof(curr_checksum));
-    if (okay && (timer_elapsed32(*last_update) >= FORCED_SYNC_THROTTLE_MS || curr_checksum != crc8(equiv_shmem, length))) {
-        okay &= transport_read(trans_id_retrieve, destination, length);
-        okay &= curr_checksum == crc8(equiv_shmem, length);
-        if (okay) {
-            *last_update = timer_read32();
-        }
-    } else {
-        memcpy(destination, equiv_shmem, length);
+    if (!transport_read(trans_id_checksum, &curr_checksum, sizeof(curr_checksum))) {
+        return SPLIT_READ_FAILED;
     }
-    return okay;
+    if (timer_elapsed32(*last_update) < FORCED_SYNC_THROTTLE_MS && curr_checksum == split_shmem_crc8(equiv_shmem, length)) {
+        split_shmem_read(destination, equiv_shmem, length);
+        return SPLIT_READ_DONE;
+    }
+    if (!transport_read(trans_id_retrieve, destination, length)) {
+        return SPLIT_READ_FAILED;
+    }
+    if (curr_checksum != crc8(destination, length)) {
+#ifdef SPLIT_TRANSPORT_THREAD
+        // The data is only asked for once its checksum changed, so it comes from an older batch until the next one
+        return SPLIT_READ_PENDING;
+#else
+        return SPLIT_READ_FAILED;
+#endif
+    }
+    *last_update = timer_read32();
+    return SPLIT_READ_DONE;
 }
 
 inline static bool send_if_condition(int8_t trans_id, uint32_t *last_update, bool condition, void *source, size_t length) {
@@ -130,7 +174,7 @@ inline static bool send_if_condition(int8_t trans_id, uint32_t *last_update, boo
 
 inline static bool send_if_data_mismatch(int8_t trans_id, uint32_t *last_update, void *source, const void *equiv_shmem, size_t length) {
     // Just run a memcmp to compare the source and equivalent shmem location
-    return send_if_condition(trans_id, last_update, (memcmp(source, equiv_shmem, length) != 0), source, length);
+    return send_if_condition(trans_id, last_update, split_shmem_differs(source, equiv_shmem, length), source, length);
 }
 
 ////////////////////////////////////////////////////
@@ -141,14 +185,14 @@ static bool slave_matrix_handlers_master(matrix_row_t master_matrix[], matrix_ro
     static matrix_row_t last_matrix[(MATRIX_ROWS) / 2] = {0}; // last successfully-read matrix, so we can replicate if there are checksum errors
     matrix_row_t        temp_matrix[(MATRIX_ROWS) / 2];       // holding area while we test whether or not checksum is correct
 
-    bool okay = read_if_checksum_mismatch(GET_SLAVE_MATRIX_CHECKSUM, GET_SLAVE_MATRIX_DATA, &last_update, temp_matrix, split_shmem->smatrix.matrix, sizeof(split_shmem->smatrix.matrix));
-    if (okay) {
+    split_read_result_t result = read_if_checksum_mismatch(GET_SLAVE_MATRIX_CHECKSUM, GET_SLAVE_MATRIX_DATA, &last_update, temp_matrix, split_shmem->smatrix.matrix, sizeof(split_shmem->smatrix.matrix));
+    if (result == SPLIT_READ_DONE) {
         // Checksum matches the received data, save as the last matrix state
         memcpy(last_matrix, temp_matrix, sizeof(temp_matrix));
     }
     // Copy out the last-known-good matrix state to the slave matrix
     memcpy(slave_matrix, last_matrix, sizeof(last_matrix));
-    return okay;
+    return result != SPLIT_READ_FAILED;
 }
 
 static void slave_matrix_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
@@ -200,9 +244,9 @@ static bool encoder_handlers_master(matrix_row_t master_matrix[], matrix_row_t s
     static uint32_t last_update = 0;
     uint8_t         temp_state[NUM_ENCODERS_MAX_PER_SIDE];
 
-    bool okay = read_if_checksum_mismatch(GET_ENCODERS_CHECKSUM, GET_ENCODERS_DATA, &last_update, temp_state, split_shmem->encoders.state, sizeof(temp_state));
-    if (okay) encoder_update_raw(temp_state);
-    return okay;
+    split_read_result_t result = read_if_checksum_mismatch(GET_ENCODERS_CHECKSUM, GET_ENCODERS_DATA, &last_update, temp_state, split_shmem->encoders.state, sizeof(temp_state));
+    if (result == SPLIT_READ_DONE) encoder_update_raw(temp_state);
+    return result != SPLIT_READ_FAILED;
 }
 
 static void encoder_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
@@ -278,9 +322,9 @@ static bool layer_state_handlers_master(matrix_row_t master_matrix[], matrix_row
     static uint32_t last_layer_state_update         = 0;
     static uint32_t last_default_layer_state_update = 0;
 
-    bool okay = send_if_condition(PUT_LAYER_STATE, &last_layer_state_update, (layer_state != split_shmem->layers.layer_state), &layer_state, sizeof(layer_state));
+    bool okay = send_if_condition(PUT_LAYER_STATE, &last_layer_state_update, split_shmem_differs(&layer_state, &split_shmem->layers.layer_state, sizeof(layer_state)), &layer_state, sizeof(layer_state));
     if (okay) {
-        okay &= send_if_condition(PUT_DEFAULT_LAYER_STATE, &last_default_layer_state_update, (default_layer_state != split_shmem->layers.default_layer_state), &default_layer_state, sizeof(default_layer_state));
+        okay &= send_if_condition(PUT_DEFAULT_LAYER_STATE, &last_default_layer_state_update, split_shmem_differs(&default_layer_state, &split_shmem->layers.default_layer_state, sizeof(default_layer_state)), &default_layer_state, sizeof(default_layer_state));
     }
     return okay;
 }
@@ -342,20 +386,21 @@ static void led_state_handlers_slave(matrix_row_t master_matrix[], matrix_row_t
 static bool mods_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     static uint32_t   last_update    = 0;
     bool              mods_need_sync = timer_elapsed32(last_update) >= FORCED_SYNC_THROTTLE_MS;
-    split_mods_sync_t new_mods;
+    split_mods_sync_t new_mods, last_mods;
+    split_shmem_read(&last_mods, &split_shmem->mods, sizeof(last_mods));
     new_mods.real_mods = get_mods();
-    if (!mods_need_sync && new_mods.real_mods != split_shmem->mods.real_mods) {
+    if (!mods_need_sync && new_mods.real_mods != last_mods.real_mods) {
         mods_need_sync = true;
     }
 
     new_mods.weak_mods = get_weak_mods();
-    if (!mods_need_sync && new_mods.weak_mods != split_shmem->mods.weak_mods) {
+    if (!mods_need_sync && new_mods.weak_mods != last_mods.weak_mods) {
         mods_need_sync = true;
     }
 
 #    ifndef NO_ACTION_ONESHOT
     new_mods.oneshot_mods = get_oneshot_mods();
-    if (!mods_need_sync && new_mods.oneshot_mods != split_shmem->mods.oneshot_mods) {
+    if (!mods_need_sync && new_mods.oneshot_mods != last_mods.oneshot_mods) {
         mods_need_sync = true;
     }
 #    endif // NO_ACTION_ONESHOT
@@ -404,7 +449,7 @@ static void mods_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave
 static bool backlight_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     static uint32_t last_update = 0;
     uint8_t         level       = is_backlight_enabled() ? get_backlight_level() : 0;
-    return send_if_condition(PUT_BACKLIGHT, &last_update, (level != split_shmem->backlight_level), &level, sizeof(level));
+    return send_if_condition(PUT_BACKLIGHT, &last_update, split_shmem_differs(&level, &split_shmem->backlight_level, sizeof(level)), &level, sizeof(level));
 }
 
 static void backlight_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
@@ -545,7 +590,7 @@ static void rgb_matrix_handlers_slave(matrix_row_t master_matrix[], matrix_row_t
 static bool wpm_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     static uint32_t last_update = 0;
     uint8_t         current_wpm = get_current_wpm();
-    return send_if_condition(PUT_WPM, &last_update, (current_wpm != split_shmem->current_wpm), &current_wpm, sizeof(current_wpm));
+    return send_if_condition(PUT_WPM, &last_update, split_shmem_differs(&current_wpm, &split_shmem->current_wpm, sizeof(current_wpm)), &current_wpm, sizeof(current_wpm));
 }
 
 static void wpm_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
@@ -572,7 +617,7 @@ static void wpm_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_
 static bool oled_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     static uint32_t last_update        = 0;
     bool            current_oled_state = is_oled_on();
-    return send_if_condition(PUT_OLED, &last_update, (current_oled_state != split_shmem->current_oled_state), &current_oled_state, sizeof(current_oled_state));
+    return send_if_condition(PUT_OLED, &last_update, split_shmem_differs(&current_oled_state, &split_shmem->current_oled_state, sizeof(current_oled_state)), &current_oled_state, sizeof(current_oled_state));
 }
 
 static void oled_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
@@ -607,7 +652,7 @@ static void oled_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave
 static bool st7565_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     static uint32_t last_update          = 0;
     bool            current_st7565_state = st7565_is_on();
-    return send_if_condition(PUT_ST7565, &last_update, (current_st7565_state != split_shmem->current_st7565_state), &current_st7565_state, sizeof(current_st7565_state));
+    return send_if_condition(PUT_ST7565, &last_update, split_shmem_differs(&current_st7565_state, &split_shmem->current_st7565_state, sizeof(current_st7565_state)), &current_st7565_state, sizeof(current_st7565_state));
 }
 
 static void st7565_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
@@ -653,12 +698,12 @@ static bool pointing_handlers_master(matrix_row_t master_matrix[], matrix_row_t
     static uint16_t last_cpi    = 0;
     report_mouse_t  temp_state;
     uint16_t        temp_cpi;
-    bool            okay = read_if_checksum_mismatch(GET_POINTING_CHECKSUM, GET_POINTING_DATA, &last_update, &temp_state, &split_shmem->pointing.report, sizeof(temp_state));
-    if (okay) pointing_device_set_shared_report(temp_state);
-    temp_cpi = pointing_device_get_shared_cpi();
+    split_read_result_t result = read_if_checksum_mismatch(GET_POINTING_CHECKSUM, GET_POINTING_DATA, &last_update, &temp_state, &split_shmem->pointing.report, sizeof(temp_state));
+    if (result == SPLIT_READ_DONE) pointing_device_set_shared_report(temp_state);
+    bool okay = result != SPLIT_READ_FAILED;
+    temp_cpi  = pointing_device_get_shared_cpi();
     if (temp_cpi && last_cpi != temp_cpi) {
-        split_shmem->pointing.cpi = temp_cpi;
-        okay                      = transport_write(PUT_POINTING_CPI, &split_shmem->pointing.cpi, sizeof(split_shmem->pointing.cpi));
+        okay = transport_write(PUT_POINTING_CPI, &temp_cpi, sizeof(temp_cpi));
         if (okay) {
             last_cpi = temp_cpi;
         }
@@ -827,7 +872,7 @@ static void activity_handlers_slave(matrix_row_t master_matrix[], matrix_row_t s
 static bool detected_os_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     static uint32_t last_detected_os_update = 0;
     os_variant_t    detected_os             = detected_host_os();
-    bool            okay                    = send_if_condition(PUT_DETECTED_OS, &last_detected_os_update, (detected_os != split_shmem->detected_os), &detected_os, sizeof(os_variant_t));
+    bool            okay                    = send_if_condition(PUT_DETECTED_OS, &last_detected_os_update, split_shmem_differs(&detected_os, &split_shmem->detected_os, sizeof(detected_os)), &detected_os, sizeof(os_variant_t));
     return okay;
 }
 
@@ -960,8 +1005,10 @@ bool transaction_rpc_exec(int8_t transaction_id, uint8_t initiator2target_buffer
     info.checksum        = crc8(&info.payload, sizeof(info.payload));
 
     // Make sure the local side knows that we're not sending the full block of data
+    split_shared_memory_lock();
     split_transaction_table[PUT_RPC_REQ_DATA].initiator2target_buffer_size  = initiator2target_buffer_size;
     split_transaction_table[GET_RPC_RESP_DATA].target2initiator_buffer_size = target2initiator_buffer_size;
+    split_shared_memory_unlock();
 
     // Run through the sequence:
     // * set the transaction ID and lengths
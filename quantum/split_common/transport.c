@@ -21,6 +21,11 @@
 #include "transport.h"
 #include "transaction_id_define.h"
 #include "atomic_util.h"
+#include "synchronization_util.h"
+
+#if defined(SPLIT_TRANSPORT_THREAD) && (defined(USE_I2C) || !defined(PROTOCOL_CHIBIOS) || defined(SERIAL_DRIVER_BITBANG))
+#    error "SPLIT_TRANSPORT_THREAD is only supported by the ChibiOS usart and vendor serial drivers"
+#endif
 
 #ifdef USE_I2C
 
@@ -104,7 +109,10 @@ bool transport_execute_transaction(int8_t id, const void *initiator2target_buf,
     split_transaction_desc_t *trans = &split_transaction_table[id];
     if (initiator2target_length > 0) {
         size_t len = trans->initiator2target_buffer_size < initiator2target_length ? trans->initiator2target_buffer_size : initiator2target_length;
+        // Locked as the shared memory may be in use by a transport thread
+        split_shared_memory_lock();
         memcpy(split_trans_initiator2target_buffer(trans), initiator2target_buf, len);
+        split_shared_memory_unlock();
     }
 
     if (!soft_serial_transaction(id)) {
@@ -113,7 +121,9 @@ bool transport_execute_transaction(int8_t id, const void *initiator2target_buf,
 
     if (target2initiator_length > 0) {
         size_t len = trans->target2initiator_buffer_size < target2initiator_length ? trans->target2initiator_buffer_size : target2initiator_length;
+        split_shared_memory_lock();
         memcpy(target2initiator_buf, split_trans_target2initiator_buffer(trans), len);
+        split_shared_memory_unlock();
     }
 
     return true;
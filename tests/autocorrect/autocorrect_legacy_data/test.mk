@@ -0,0 +1,11 @@
+# Copyright 2023 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+# --------------------------------------------------------------------------------
+# Keep this file, even if it is empty, as a marker that this folder contains tests
+# --------------------------------------------------------------------------------
+
+AUTOCORRECT_ENABLE = yes
+
+# The autocorrect tests, run against the unversioned autocorrect_data.h in this folder
+SRC += ../test_autocorrect.cpp
@@ -0,0 +1,26 @@
+# Copyright 2023 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+AUTOCORRECT_ENABLE = yes
+
+# The 10k entry dictionary is too large to check in, generate it and its trie for every build
+QMK_BIN ?= qmk
+AUTOCORRECT_BENCH_OUTPUT := $(BUILD_DIR)/test/$(TEST)_autocorrect
+
+$(AUTOCORRECT_BENCH_OUTPUT)/dictionary.txt: $(TEST_PATH)/make_dictionary.py
+	@mkdir -p $(@D)
+	@$(SILENT) || printf "$(MSG_GENERATING) $@" | $(AWK_CMD)
+	$(eval CMD=python3 $< > $@)
+	@$(BUILD_CMD)
+
+# A failed or skipped generation must not fall back to the default dictionary, so check the header exists
+$(AUTOCORRECT_BENCH_OUTPUT)/autocorrect_data.h: $(AUTOCORRECT_BENCH_OUTPUT)/dictionary.txt
+	@$(SILENT) || printf "$(MSG_GENERATING) $@" | $(AWK_CMD)
+	$(eval CMD=rm -f $@ && $(QMK_BIN) generate-autocorrect-data --quiet --output $@ $< && test -f $@)
+	@$(BUILD_CMD)
+
+# Both pick the header up through VPATH, it has to be there before either compiles
+$(TEST_OBJ)/$(TEST)/quantum/process_keycode/process_autocorrect.o $(TEST_OBJ)/$(TEST)/tests/bench/autocorrect/bench_autocorrect.o: $(AUTOCORRECT_BENCH_OUTPUT)/autocorrect_data.h
+
+OPT_DEFS += -DAUTOCORRECT_BENCH_DICTIONARY=\"$(AUTOCORRECT_BENCH_OUTPUT)/dictionary.txt\"
+VPATH += $(AUTOCORRECT_BENCH_OUTPUT)
@@ -0,0 +1,63 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <fstream>
+#include <string>
+#include "bench_fixture.hpp"
+
+extern "C" {
+#include "process_autocorrect.h"
+}
+
+static uint32_t corrections;
+
+extern "C" bool apply_autocorrect(uint8_t backspaces, const char *str) {
+    corrections++;
+    return true;
+}
+
+class Autocorrect : public BenchFixture {
+   protected:
+    void SetUp() override {
+        autocorrect_enable();
+    }
+
+    /* Every `step`th typo of the generated dictionary, separated by spaces. */
+    static std::string typos(size_t step, size_t &count) {
+        std::ifstream dictionary(AUTOCORRECT_BENCH_DICTIONARY);
+        std::string   typo, arrow, correction, text;
+        count = 0;
+        for (size_t i = 0; dictionary >> typo >> arrow >> correction; i++) {
+            if (i % step == 0) {
+                text += typo + ' ';
+                count++;
+            }
+        }
+        return text;
+    }
+};
+
+TEST_F(Autocorrect, Prose) {
+    auto keys = qwerty_keymap();
+    set_keymap(keys);
+
+    TraceBuilder builder;
+    builder.type(bench_corpus, keys, 0, 80);
+    replay("autocorrect 10k prose", builder.build(), 20);
+}
+
+TEST_F(Autocorrect, Typos) {
+    auto keys = qwerty_keymap();
+    set_keymap(keys);
+
+    size_t      count;
+    std::string text = typos(50, count);
+    ASSERT_FALSE(text.empty()) << "no dictionary at " AUTOCORRECT_BENCH_DICTIONARY;
+
+    TraceBuilder builder;
+    builder.type(text.c_str(), keys, 0, 80);
+    corrections = 0;
+    replay("autocorrect 10k typos", builder.build(), 20);
+    // Typos never contain one another, so each one is corrected exactly once, none of them are in the default dictionary
+    EXPECT_EQ(corrections, count * 20);
+}
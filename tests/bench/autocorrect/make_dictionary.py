@@ -0,0 +1,49 @@
+#!/usr/bin/env python3
+# Copyright 2023 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+"""Writes a large synthetic autocorrect dictionary for the autocorrect benchmark.
+
+Words are glued together from common English syllables so the reversed trie shares
+suffixes the way a real dictionary does, each typo swaps two neighbouring letters.
+The output only depends on the seed, so benchmark runs are comparable.
+"""
+
+import random
+import sys
+
+SYLLABLES = [
+    'a', 'ab', 'ac', 'ad', 'al', 'am', 'an', 'ap', 'ar', 'as', 'at', 'ba', 'be', 'bi', 'bo', 'ca', 'ce', 'ci', 'co', 'com', 'con', 'cu', 'da', 'de', 'di', 'dis', 'do', 'e', 'el', 'em', 'en', 'er', 'es', 'ex', 'fa', 'fi', 'fo', 'for', 'ga', 'ge', 'gi', 'go', 'ha', 'he', 'hi', 'ho', 'i', 'im', 'in', 'ir', 'is', 'la', 'le', 'li', 'lo', 'lu', 'ma', 'me', 'mi', 'mo', 'na', 'ne', 'ni', 'no', 'o', 'ob', 'on', 'or', 'pa', 'pe', 'per', 'pi', 'po', 'pre', 'pro', 'ra', 're', 'ri', 'ro', 'sa', 'se', 'si', 'so', 'sta', 'su', 'ta', 'te', 'ter', 'ti', 'to', 'tra', 'tu', 'un', 'va', 've', 'vi'
+]
+ENDINGS = ['', 'al', 'ate', 'ed', 'er', 'ing', 'ion', 'ity', 'ive', 'ly', 'ment', 'ness', 'ous', 's', 'tion', 'ure']
+
+
+def words(rng):
+    while True:
+        word = ''.join(rng.choice(SYLLABLES) for _ in range(rng.randint(2, 3))) + rng.choice(ENDINGS)
+        if 7 <= len(word) <= 14:
+            yield word
+
+
+def main(count=10000, seed=1):
+    rng = random.Random(seed)
+    typos = {}
+    substrings = set()
+    for word in words(rng):
+        if len(typos) == count:
+            break
+        i = rng.randint(1, len(word) - 3)
+        if word[i] == word[i + 1]:
+            continue
+        typo = word[:i] + word[i + 1] + word[i] + word[i + 2:]
+        # Typos may not contain one another, the generator would refuse the dictionary
+        if typo in substrings or any(typo[a:b] in typos for a in range(len(typo)) for b in range(a + 1, len(typo) + 1)):
+            continue
+        typos[typo] = word
+        substrings.update(typo[a:b] for a in range(len(typo)) for b in range(a + 1, len(typo) + 1))
+
+    for typo, word in typos.items():
+        print(f'{typo} -> {word}')
+
+
+if __name__ == '__main__':
+    main(*map(int, sys.argv[1:]))
@@ -0,0 +1,41 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <cstdio>
+#include "bench_fixture.hpp"
+
+extern "C" {
+#include "effects_harness.h"
+}
+
+#define FRAMES 2000
+
+/* Renders every effect of whichever of RGB Matrix and LED Matrix the suite enables,
+ * through the same harness as the golden frame tests in platforms/test. Shared by the
+ * rgb_matrix and led_matrix suites, see effects.mk. */
+class Effects : public TestFixture {
+   protected:
+    void report(uint8_t mode) {
+        const char* name = effects_harness_effect_name(mode);
+        const char* unit = effects_harness_cycle_unit();
+
+        effects_harness_result_t result;
+        auto                     start = std::chrono::steady_clock::now();
+        effects_harness_run(mode, FRAMES, &result);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        double leds    = (double)result.frames * effects_harness_led_count();
+
+        // The wall time includes hashing the frames, the cycle count only covers the matrix task
+        printf("[ BENCH    ] %s: %.0f LEDs/s, %.1f %s/LED\n", name, leds / seconds, result.cycles / leds, unit);
+        ::testing::Test::RecordProperty(std::string(name) + "_leds_per_second", std::to_string((uint64_t)(leds / seconds)));
+        ::testing::Test::RecordProperty(std::string(name) + "_" + unit + "_per_led", std::to_string((uint64_t)(result.cycles / leds)));
+    }
+};
+
+TEST_F(Effects, Render) {
+    effects_harness_init();
+    for (uint8_t mode = 1; mode < effects_harness_effect_count(); mode++) {
+        report(mode);
+    }
+}
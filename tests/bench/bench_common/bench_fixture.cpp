@@ -0,0 +1,174 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <cstdio>
+#include "bench_fixture.hpp"
+#include "test_matrix.h"
+
+#if defined(__linux__)
+#    include <linux/perf_event.h>
+#    include <sys/ioctl.h>
+#    include <sys/syscall.h>
+#    include <unistd.h>
+#endif
+#if defined(__x86_64__) || defined(__i386__)
+#    include <x86intrin.h>
+#endif
+
+extern "C" {
+#include "quantum.h"
+
+void advance_time(uint32_t ms);
+}
+
+InstructionCounter::InstructionCounter() {
+#if defined(__linux__)
+    struct perf_event_attr attr = {};
+    attr.type                   = PERF_TYPE_HARDWARE;
+    attr.size                   = sizeof(attr);
+    attr.config                 = PERF_COUNT_HW_INSTRUCTIONS;
+    attr.disabled               = 1;
+    attr.exclude_kernel         = 1;
+    attr.exclude_hv             = 1;
+    m_fd                        = syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+#endif
+}
+
+InstructionCounter::~InstructionCounter() {
+#if defined(__linux__)
+    if (m_fd >= 0) {
+        close(m_fd);
+    }
+#endif
+}
+
+bool InstructionCounter::available() const {
+#if defined(__x86_64__) || defined(__i386__)
+    return true;
+#else
+    return m_fd >= 0;
+#endif
+}
+
+const char* InstructionCounter::unit() const {
+    return m_fd >= 0 ? "instructions" : "cycles";
+}
+
+void InstructionCounter::start() {
+#if defined(__linux__)
+    if (m_fd >= 0) {
+        ioctl(m_fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(m_fd, PERF_EVENT_IOC_ENABLE, 0);
+        return;
+    }
+#endif
+#if defined(__x86_64__) || defined(__i386__)
+    m_start = __rdtsc();
+#endif
+}
+
+uint64_t InstructionCounter::stop() {
+#if defined(__linux__)
+    if (m_fd >= 0) {
+        uint64_t count = 0;
+        ioctl(m_fd, PERF_EVENT_IOC_DISABLE, 0);
+        if (read(m_fd, &count, sizeof(count)) != sizeof(count)) {
+            return 0;
+        }
+        return count;
+    }
+#endif
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc() - m_start;
+#else
+    return 0;
+#endif
+}
+
+void BenchFixture::set_keymap(const std::vector<KeymapKey>& keys) {
+    keymap.clear();
+    for (const KeymapKey& key : keys) {
+        add_key(key);
+    }
+}
+
+std::vector<KeymapKey> BenchFixture::qwerty_keymap(const std::map<uint16_t, uint16_t>& overrides) {
+    static const uint16_t layout[MATRIX_ROWS][MATRIX_COLS] = {
+        {KC_Q, KC_W, KC_E, KC_R, KC_T, KC_Y, KC_U, KC_I, KC_O, KC_P},
+        {KC_A, KC_S, KC_D, KC_F, KC_G, KC_H, KC_J, KC_K, KC_L, KC_COMMA},
+        {KC_Z, KC_X, KC_C, KC_V, KC_B, KC_N, KC_M, KC_DOT, KC_LSFT, KC_NO},
+        {KC_SPACE, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO},
+    };
+
+    std::vector<KeymapKey> keys;
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            uint16_t keycode  = layout[row][col];
+            auto     override = overrides.find(keycode);
+            if (keycode != KC_NO) {
+                keys.push_back(KeymapKey(0, col, row, override != overrides.end() ? override->second : keycode));
+            }
+        }
+    }
+    return keys;
+}
+
+BenchResult BenchFixture::replay(const char* name, const Trace& trace, unsigned iterations) {
+    std::vector<uint32_t> handler_calls(process_record_handler_count());
+    for (uint8_t i = 0; i < handler_calls.size(); i++) {
+        handler_calls[i] = process_record_handler_call_count(i);
+    }
+
+    BenchResult result = {};
+    auto        start  = std::chrono::steady_clock::now();
+    counter.start();
+    for (unsigned iteration = 0; iteration < iterations; iteration++) {
+        for (const TraceEvent& event : trace) {
+            for (uint16_t i = 0; i < event.delay; i++) {
+                keyboard_task();
+                advance_time(1);
+            }
+            if (event.pressed) {
+                press_key(event.col, event.row);
+            } else {
+                release_key(event.col, event.row);
+            }
+            result.scan_loops += event.delay;
+        }
+        result.events += trace.size();
+    }
+    result.counter = counter.stop();
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    for (uint8_t i = 0; i < handler_calls.size(); i++) {
+        handler_calls[i] = process_record_handler_call_count(i) - handler_calls[i];
+    }
+    report(name, result, handler_calls);
+
+    // Let the last release through before the fixture checks for stuck keys
+    idle_for(TAPPING_TERM * 2);
+    return result;
+}
+
+void BenchFixture::report(const char* name, const BenchResult& result, const std::vector<uint32_t>& handler_calls) const {
+    double events = result.events ? result.events : 1;
+
+    printf("[ BENCH    ] %s: %llu events, %llu scan loops, %.3f ms\n", name, (unsigned long long)result.events, (unsigned long long)result.scan_loops, result.seconds * 1000);
+    printf("[ BENCH    ] %s: %.0f events/s", name, result.events / result.seconds);
+    if (counter.available()) {
+        printf(", %.0f %s/event", result.counter / events, counter.unit());
+    }
+    printf("\n");
+    for (uint8_t i = 0; i < handler_calls.size(); i++) {
+        if (handler_calls[i]) {
+            printf("[ BENCH    ] %s:   %-32s %8u calls, %.2f/event\n", name, process_record_handler_name(i), handler_calls[i], handler_calls[i] / events);
+        }
+    }
+
+    ::testing::Test::RecordProperty("events", std::to_string(result.events));
+    ::testing::Test::RecordProperty("events_per_second", std::to_string((uint64_t)(result.events / result.seconds)));
+    if (counter.available()) {
+        ::testing::Test::RecordProperty(std::string(counter.unit()) + "_per_event", std::to_string((uint64_t)(result.counter / events)));
+    }
+}
@@ -0,0 +1,64 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <vector>
+#include "test_common.hpp"
+#include "trace_builder.hpp"
+
+/**
+ * @brief Counts retired instructions of the calling thread, using perf_event_open
+ * where the kernel allows it and the CPU timestamp counter otherwise.
+ */
+class InstructionCounter {
+   public:
+    InstructionCounter();
+    ~InstructionCounter();
+
+    void        start();
+    uint64_t    stop();
+    const char* unit() const;
+    bool        available() const;
+
+   private:
+    int      m_fd = -1;
+    uint64_t m_start;
+};
+
+struct BenchResult {
+    uint64_t events;
+    uint64_t scan_loops;
+    double   seconds;
+    uint64_t counter; // instructions, or cycles when perf events are unavailable
+};
+
+/**
+ * @brief Replays keystroke traces through the whole keyboard pipeline
+ * (matrix scan, action_exec, process_record_quantum) and reports throughput.
+ *
+ * Traces are fed straight into the test matrix, with one keyboard_task() per
+ * millisecond of trace time, bypassing the test logger so that only firmware
+ * code is measured. Reports go to a mock driver with no expectations.
+ */
+class BenchFixture : public TestFixture {
+   protected:
+    testing::NiceMock<TestDriver> driver;
+
+    using TestFixture::set_keymap;
+    void set_keymap(const std::vector<KeymapKey>& keys);
+
+    /* A QWERTY layout on layer 0 with comma, dot, space and left shift, where `overrides`
+     * replaces the keycode of some of the keys, e.g. {KC_A, LGUI_T(KC_A)}. */
+    static std::vector<KeymapKey> qwerty_keymap(const std::map<uint16_t, uint16_t>& overrides = {});
+
+    /* Replays `trace` `iterations` times and prints the results under `name`. */
+    BenchResult replay(const char* name, const Trace& trace, unsigned iterations);
+
+   private:
+    void report(const char* name, const BenchResult& result, const std::vector<uint32_t>& handler_calls) const;
+
+    InstructionCounter counter;
+};
@@ -0,0 +1,11 @@
+# Copyright 2023 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+# Shared by every benchmark in tests/bench, included ahead of the suite's bench.mk
+OPT_DEFS += -DPROCESS_RECORD_HANDLER_STATS
+
+SRC += \
+	tests/bench/bench_common/bench_fixture.cpp \
+	tests/bench/bench_common/trace_builder.cpp
+
+VPATH += $(TOP_DIR)/tests/bench/bench_common
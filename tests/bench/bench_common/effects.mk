@@ -0,0 +1,9 @@
+# Copyright 2023 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+# Shared by the rgb_matrix and led_matrix benchmarks, included from their bench.mk
+# once they have enabled the matrix type to render
+
+SRC += \
+	tests/bench/bench_common/bench_effects.cpp \
+	platforms/test/effects_harness.c
@@ -0,0 +1,125 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <cctype>
+#include "trace_builder.hpp"
+
+extern "C" {
+#include "quantum_keycodes.h"
+}
+
+const char bench_corpus[] =
+    "The quick brown fox jumps over the lazy dog. Keyboards spend most of their life idle, "
+    "but when they are busy the scan loop has to keep up with bursts of fast, overlapping "
+    "keystrokes. Typists roll from one key to the next, pressing the following key before "
+    "releasing the previous one, and home row modifiers turn every one of those rolls into "
+    "a decision between a tap and a hold. Pack my box with five dozen liquor jugs. "
+    "How vexingly quick daft zebras jump, said Jackdaws, who love my big sphinx of quartz.";
+
+static char tap_character(uint16_t keycode) {
+    if (IS_QK_MOD_TAP(keycode)) {
+        keycode = QK_MOD_TAP_GET_TAP_KEYCODE(keycode);
+    } else if (IS_QK_LAYER_TAP(keycode)) {
+        keycode = QK_LAYER_TAP_GET_TAP_KEYCODE(keycode);
+    }
+    if (keycode >= KC_A && keycode <= KC_Z) {
+        return 'a' + (keycode - KC_A);
+    }
+    switch (keycode) {
+        case KC_SPACE:
+            return ' ';
+        case KC_COMMA:
+            return ',';
+        case KC_DOT:
+            return '.';
+        default:
+            return 0;
+    }
+}
+
+uint32_t TraceBuilder::type(const char* text, const std::vector<KeymapKey>& keymap, uint32_t time, uint32_t wpm) {
+    const KeymapKey* keys[128] = {};
+    const KeymapKey* shift     = nullptr;
+    for (const KeymapKey& key : keymap) {
+        if (key.layer != 0) {
+            continue;
+        }
+        if (key.code == KC_LSFT) {
+            shift = &key;
+        } else if (char c = tap_character(key.code)) {
+            keys[(uint8_t)c] = &key;
+        }
+    }
+
+    // Five characters per word, each key held for around one interval so that about half the strokes roll over
+    uint32_t interval = 12000 / wpm;
+    for (const char* c = text; *c; c++) {
+        const KeymapKey* key = keys[std::tolower((unsigned char)*c) & 0x7F];
+        if (!key) {
+            continue;
+        }
+        uint32_t hold = jitter(interval, interval / 2);
+        if (std::isupper((unsigned char)*c) && shift) {
+            stroke(*shift, time, hold + 30);
+            time += 15;
+        }
+        stroke(*key, time, hold);
+        time += jitter(interval, interval / 3);
+    }
+    return time;
+}
+
+uint32_t TraceBuilder::stroke(const KeymapKey& key, uint32_t time, uint32_t hold) {
+    uint16_t position = (key.position.row << 8) | key.position.col;
+    auto     released = m_released_at.find(position);
+    if (released != m_released_at.end() && time <= released->second) {
+        time = released->second + 1;
+    }
+
+    uint32_t release_time = time + std::max<uint32_t>(hold, 1);
+    add(key, time, true);
+    add(key, release_time, false);
+    m_released_at[position] = release_time;
+    return release_time;
+}
+
+uint32_t TraceBuilder::chord(const std::vector<KeymapKey>& keys, uint32_t time, uint32_t hold) {
+    uint32_t last_release = time;
+    for (const KeymapKey& key : keys) {
+        last_release = std::max(last_release, stroke(key, time + jitter(2, 2), jitter(hold, hold / 4)));
+    }
+    return last_release;
+}
+
+uint32_t TraceBuilder::jitter(uint32_t base, uint32_t spread) {
+    // xorshift32, good enough for spreading out key timings
+    m_seed ^= m_seed << 13;
+    m_seed ^= m_seed >> 17;
+    m_seed ^= m_seed << 5;
+    if (spread == 0) {
+        return base;
+    }
+    uint32_t offset = m_seed % (2 * spread + 1);
+    return base + offset > spread ? base + offset - spread : 0;
+}
+
+void TraceBuilder::add(const KeymapKey& key, uint32_t time, bool pressed) {
+    m_events.push_back({time, static_cast<uint32_t>(m_events.size()), key.position.col, key.position.row, pressed});
+}
+
+Trace TraceBuilder::build() const {
+    std::vector<TimedEvent> sorted = m_events;
+    std::stable_sort(sorted.begin(), sorted.end(), [](const TimedEvent& a, const TimedEvent& b) { return a.time < b.time; });
+
+    Trace    trace;
+    uint32_t now = 0;
+    trace.reserve(sorted.size());
+    for (const TimedEvent& event : sorted) {
+        // Pauses are capped at about a minute, nothing in the pipeline waits longer than that
+        uint16_t delay = static_cast<uint16_t>(std::min<uint32_t>(event.time - now, UINT16_MAX));
+        trace.push_back({delay, event.col, event.row, event.pressed});
+        now = event.time;
+    }
+    return trace;
+}
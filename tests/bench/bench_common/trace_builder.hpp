@@ -0,0 +1,65 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <vector>
+#include "test_keymap_key.hpp"
+
+/**
+ * @brief A single key transition of a keystroke trace.
+ */
+struct TraceEvent {
+    uint16_t delay; // scan loops (ms) to run before this transition
+    uint8_t  col;
+    uint8_t  row;
+    bool     pressed;
+};
+
+using Trace = std::vector<TraceEvent>;
+
+/* A few paragraphs of English prose, for typing traces. */
+extern const char bench_corpus[];
+
+/**
+ * @brief Builds keystroke traces from timestamped presses and releases.
+ *
+ * Transitions may be added in any order, build() sorts them by time and turns
+ * the timestamps into per-event delays. A key is never pressed again before its
+ * previous release, so overlapping strokes of the same key are pushed back.
+ * Timing jitter comes from a fixed-seed generator, so traces are reproducible.
+ */
+class TraceBuilder {
+   public:
+    explicit TraceBuilder(uint32_t seed = 1) : m_seed(seed) {}
+
+    /* Press `key` at `time` and hold it for `hold` ms, returns the release time. */
+    uint32_t stroke(const KeymapKey& key, uint32_t time, uint32_t hold);
+    /* Press all `keys` together at `time`, releasing them within `hold` ms. */
+    uint32_t chord(const std::vector<KeymapKey>& keys, uint32_t time, uint32_t hold);
+    /* Types `text` at about `wpm` words per minute from `time`, returns the time it finished.
+     * Characters are looked up by the tap keycode of the keys in `keymap`, upper case letters
+     * are typed with a KC_LSFT key held, and characters with no key are skipped. */
+    uint32_t type(const char* text, const std::vector<KeymapKey>& keymap, uint32_t time, uint32_t wpm);
+    /* Returns `base` ± `spread`, drawn from the builder's generator. */
+    uint32_t jitter(uint32_t base, uint32_t spread);
+
+    Trace build() const;
+
+   private:
+    struct TimedEvent {
+        uint32_t time;
+        uint32_t order;
+        uint8_t  col;
+        uint8_t  row;
+        bool     pressed;
+    };
+
+    void add(const KeymapKey& key, uint32_t time, bool pressed);
+
+    std::vector<TimedEvent>       m_events;
+    std::map<uint16_t, uint32_t> m_released_at;
+    uint32_t                      m_seed;
+};
@@ -0,0 +1,60 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "bench_fixture.hpp"
+
+class HomeRowMods : public BenchFixture {
+   protected:
+    std::vector<KeymapKey> keys = qwerty_keymap({
+        {KC_A, LGUI_T(KC_A)},
+        {KC_S, LALT_T(KC_S)},
+        {KC_D, LSFT_T(KC_D)},
+        {KC_F, LCTL_T(KC_F)},
+        {KC_J, RCTL_T(KC_J)},
+        {KC_K, RSFT_T(KC_K)},
+        {KC_L, LALT_T(KC_L)},
+        {KC_COMMA, RGUI_T(KC_COMMA)},
+    });
+
+    const KeymapKey& key(uint16_t keycode) const {
+        return *std::find_if(keys.begin(), keys.end(), [&](const KeymapKey& key) { return key.code == keycode; });
+    }
+};
+
+TEST_F(HomeRowMods, Prose) {
+    set_keymap(keys);
+
+    TraceBuilder builder;
+    builder.type(bench_corpus, keys, 0, 80);
+    replay("home row mods 80wpm", builder.build(), 20);
+}
+
+TEST_F(HomeRowMods, FastProse) {
+    set_keymap(keys);
+
+    TraceBuilder builder;
+    builder.type(bench_corpus, keys, 0, 160);
+    replay("home row mods 160wpm", builder.build(), 20);
+}
+
+TEST_F(HomeRowMods, Shortcuts) {
+    set_keymap(keys);
+
+    // Held home row mods with a burst of keys under them, e.g. ctrl+c / ctrl+v and shifted words
+    const uint16_t mods[]    = {LCTL_T(KC_F), LSFT_T(KC_D), LGUI_T(KC_A), RCTL_T(KC_J)};
+    const uint16_t targets[] = {KC_C, KC_V, KC_X, KC_Z, KC_T, KC_W, KC_E};
+
+    TraceBuilder builder;
+    uint32_t     time = 0;
+    for (unsigned i = 0; i < 500; i++) {
+        const KeymapKey& mod   = key(mods[i % 4]);
+        uint32_t         start = time;
+        time += builder.jitter(TAPPING_TERM + 30, 20);
+        for (unsigned j = 0; j < 1 + i % 3; j++) {
+            time = builder.stroke(key(targets[(i + j) % 7]), time, builder.jitter(60, 20)) + builder.jitter(40, 10);
+        }
+        builder.stroke(mod, start, time - start);
+        time += builder.jitter(150, 50);
+    }
+    replay("home row mods shortcuts", builder.build(), 5);
+}
@@ -0,0 +1,50 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "bench_fixture.hpp"
+
+extern "C" {
+#include "bench_key_overrides.h"
+}
+
+class KeyOverride : public BenchFixture {
+   protected:
+    void SetUp() override {
+        bench_key_overrides_init();
+    }
+};
+
+TEST_F(KeyOverride, Prose) {
+    auto keys = qwerty_keymap();
+    set_keymap(keys);
+
+    TraceBuilder builder;
+    builder.type(bench_corpus, keys, 0, 80);
+    replay("208 key overrides prose", builder.build(), 100);
+}
+
+TEST_F(KeyOverride, Shortcuts) {
+    // Comma becomes left ctrl, every shortcut activates an override
+    auto keys = qwerty_keymap({{KC_COMMA, KC_LCTL}});
+    set_keymap(keys);
+
+    const KeymapKey*       ctrl = nullptr;
+    std::vector<KeymapKey> letters;
+    for (const KeymapKey& key : keys) {
+        if (key.code == KC_LCTL) ctrl = &key;
+        if (IS_BASIC_KEYCODE(key.code) && key.code <= KC_Z) letters.push_back(key);
+    }
+
+    TraceBuilder builder;
+    uint32_t     time = 0;
+    for (unsigned i = 0; i < 500; i++) {
+        uint32_t start = time;
+        time += builder.jitter(80, 20);
+        for (unsigned j = 0; j < 1 + i % 3; j++) {
+            time = builder.stroke(letters[(i * 7 + j) % letters.size()], time, builder.jitter(60, 20)) + builder.jitter(40, 10);
+        }
+        builder.stroke(*ctrl, start, time - start);
+        time += builder.jitter(150, 50);
+    }
+    replay("208 key overrides shortcuts", builder.build(), 20);
+}
@@ -0,0 +1,27 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "quantum.h"
+#include "bench_key_overrides.h"
+
+static key_override_t        overrides[BENCH_KEY_OVERRIDE_COUNT];
+static const key_override_t *override_list[BENCH_KEY_OVERRIDE_COUNT + 1];
+
+const key_override_t **key_overrides = NULL;
+
+void bench_key_overrides_init(void) {
+    static const uint8_t mod_combos[BENCH_KEY_OVERRIDE_MOD_COMBOS] = {
+        MOD_MASK_CTRL, MOD_MASK_ALT, MOD_MASK_GUI, MOD_MASK_CS, MOD_MASK_CA, MOD_MASK_SA, MOD_MASK_SG, MOD_MASK_CG,
+    };
+
+    uint16_t n = 0;
+    for (uint8_t combo = 0; combo < BENCH_KEY_OVERRIDE_MOD_COMBOS; combo++) {
+        for (uint16_t trigger = KC_A; trigger <= KC_Z; trigger++, n++) {
+            // Odd combinations only apply to the lower layers, so layer checks reject some candidates too
+            overrides[n]     = ko_make_with_layers(mod_combos[combo], trigger, KC_A + (trigger - KC_A + 1 + combo) % 26, combo & 1 ? 0x3 : ~0);
+            override_list[n] = &overrides[n];
+        }
+    }
+    override_list[n] = NULL;
+    key_overrides    = override_list;
+}
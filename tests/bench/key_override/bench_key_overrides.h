@@ -0,0 +1,11 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+// Every letter gets an override for each of the modifier combinations, but never for shift alone
+#define BENCH_KEY_OVERRIDE_MOD_COMBOS 8
+#define BENCH_KEY_OVERRIDE_COUNT (26 * BENCH_KEY_OVERRIDE_MOD_COMBOS)
+
+/* Points key_overrides at BENCH_KEY_OVERRIDE_COUNT overrides, listed modifier combination by modifier combination. */
+void bench_key_overrides_init(void);
@@ -0,0 +1,10 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+// One LED per key, plus a ring of underglow, with every effect enabled
+#define RGB_MATRIX_LED_COUNT 60
+#include "effects_harness_config.h"
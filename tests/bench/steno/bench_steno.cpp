@@ -0,0 +1,47 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "bench_fixture.hpp"
+
+extern "C" {
+#include "keymap_steno.h"
+
+static uint32_t bytes_sent;
+
+// No virtual serial port on the host, just count what would go over it
+void virtser_init(void) {}
+
+void virtser_send(const uint8_t byte) {
+    bytes_sent++;
+}
+}
+
+class Steno : public BenchFixture {
+   protected:
+    // Steno order, left bank on row 0, vowels on row 1 and right bank on row 2
+    std::vector<KeymapKey> keys = {
+        KeymapKey(0, 0, 0, STN_S1), KeymapKey(0, 1, 0, STN_TL), KeymapKey(0, 2, 0, STN_KL), KeymapKey(0, 3, 0, STN_PL), KeymapKey(0, 4, 0, STN_WL), KeymapKey(0, 5, 0, STN_HL), KeymapKey(0, 6, 0, STN_RL), KeymapKey(0, 7, 0, STN_ST1),
+        KeymapKey(0, 0, 1, STN_A),  KeymapKey(0, 1, 1, STN_O),  KeymapKey(0, 2, 1, STN_E),  KeymapKey(0, 3, 1, STN_U),  KeymapKey(0, 4, 1, STN_N1),
+        KeymapKey(0, 0, 2, STN_FR), KeymapKey(0, 1, 2, STN_RR), KeymapKey(0, 2, 2, STN_PR), KeymapKey(0, 3, 2, STN_BR), KeymapKey(0, 4, 2, STN_LR), KeymapKey(0, 5, 2, STN_GR), KeymapKey(0, 6, 2, STN_TR), KeymapKey(0, 7, 2, STN_SR), KeymapKey(0, 8, 2, STN_DR), KeymapKey(0, 9, 2, STN_ZR),
+    };
+};
+
+TEST_F(Steno, Chords) {
+    set_keymap(keys);
+
+    // Random strokes of one to seven keys, at around 200 words per minute
+    TraceBuilder builder(7);
+    uint32_t     time = 0;
+    for (unsigned i = 0; i < 2000; i++) {
+        std::vector<KeymapKey> chord;
+        unsigned               size = 1 + builder.jitter(3, 3);
+        for (unsigned j = 0; j < size; j++) {
+            chord.push_back(keys[builder.jitter(11, 11)]);
+        }
+        time = builder.chord(chord, time, 90) + builder.jitter(200, 60);
+    }
+
+    bytes_sent = 0;
+    replay("steno chords", builder.build(), 5);
+    EXPECT_GT(bytes_sent, 0);
+}
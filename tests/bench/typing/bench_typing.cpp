@@ -0,0 +1,24 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "bench_fixture.hpp"
+
+class Typing : public BenchFixture {};
+
+TEST_F(Typing, Prose) {
+    auto keys = qwerty_keymap();
+    set_keymap(keys);
+
+    TraceBuilder builder;
+    builder.type(bench_corpus, keys, 0, 80);
+    replay("typing 80wpm", builder.build(), 100);
+}
+
+TEST_F(Typing, FastProse) {
+    auto keys = qwerty_keymap();
+    set_keymap(keys);
+
+    TraceBuilder builder;
+    builder.type(bench_corpus, keys, 0, 160);
+    replay("typing 160wpm", builder.build(), 100);
+}
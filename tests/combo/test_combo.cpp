@@ -55,3 +55,67 @@ TEST_F(Combo, combo_osmshift_tapped) {
     tap_key(key_i);
     VERIFY_AND_CLEAR(driver);
 }
+
+// Combo events come from key (0, 0), which mustn't be mistaken for the mod-tap key at that position
+TEST_F(Combo, combo_tapped_while_buffered_mod_tap_at_0_0_is_held) {
+    TestDriver driver;
+    InSequence s;
+    KeymapKey  key_a(0, 0, 0, LSFT_T(KC_A));
+    KeymapKey  key_b(0, 1, 0, LCTL_T(KC_B));
+    KeymapKey  key_y(0, 0, 1, KC_Y);
+    KeymapKey  key_u(0, 0, 2, KC_U);
+    set_keymap({key_a, key_b, key_y, key_u});
+
+    EXPECT_NO_REPORT(driver);
+    key_b.press();
+    run_one_scan_loop();
+    key_a.press();
+    run_one_scan_loop();
+    tap_combo({key_y, key_u});
+    key_a.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_REPORT(driver, (KC_A, KC_B));
+    EXPECT_REPORT(driver, (KC_A, KC_B, KC_SPACE));
+    EXPECT_REPORT(driver, (KC_A, KC_B));
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    key_b.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(Combo, combo_mod_tap_result_while_mod_tap_at_0_0_is_held) {
+    TestDriver driver;
+    InSequence s;
+    KeymapKey  key_a(0, 0, 0, LSFT_T(KC_A));
+    KeymapKey  key_b(0, 1, 0, LCTL_T(KC_B));
+    KeymapKey  key_y(0, 0, 1, KC_Y);
+    KeymapKey  key_u(0, 0, 2, KC_U);
+    set_keymap({key_a, key_b, key_y, key_u});
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    key_a.press();
+    key_y.press();
+    key_u.press();
+    run_one_scan_loop();
+    key_b.press();
+    key_a.release();
+    run_one_scan_loop();
+    key_y.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_SPACE));
+    EXPECT_REPORT(driver, (KC_B, KC_SPACE));
+    EXPECT_REPORT(driver, (KC_SPACE));
+    EXPECT_EMPTY_REPORT(driver);
+    key_b.release();
+    run_one_scan_loop();
+    key_u.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
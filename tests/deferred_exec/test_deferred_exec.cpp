@@ -0,0 +1,124 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <vector>
+
+#include "test_common.hpp"
+
+extern "C" {
+#include "deferred_exec.h"
+
+void advance_time(uint32_t ms);
+}
+
+#define TABLE_SIZE 8
+
+static std::vector<uintptr_t> calls;
+
+static uint32_t record_callback(uint32_t trigger_time, void *cb_arg) {
+    calls.push_back((uintptr_t)cb_arg);
+    return 0;
+}
+
+static uint32_t repeat_callback(uint32_t trigger_time, void *cb_arg) {
+    calls.push_back((uintptr_t)cb_arg);
+    return 1;
+}
+
+class DeferredExec : public TestFixture {
+   protected:
+    deferred_executor_t table[TABLE_SIZE] = {};
+    uint32_t            last_exec         = 0;
+
+    void SetUp() override {
+        calls.clear();
+        last_exec = timer_read32();
+    }
+
+    void run_for(uint32_t ms) {
+        for (uint32_t i = 0; i < ms; i++) {
+            advance_time(1);
+            deferred_exec_advanced_task(table, TABLE_SIZE, &last_exec);
+        }
+    }
+};
+
+TEST_F(DeferredExec, CallbacksRunInTriggerOrder) {
+    defer_exec_advanced(table, TABLE_SIZE, 30, record_callback, (void *)3);
+    defer_exec_advanced(table, TABLE_SIZE, 10, record_callback, (void *)1);
+    defer_exec_advanced(table, TABLE_SIZE, 20, record_callback, (void *)2);
+
+    run_for(9);
+    EXPECT_TRUE(calls.empty());
+    run_for(1);
+    EXPECT_EQ(calls, std::vector<uintptr_t>({1}));
+    run_for(20);
+    EXPECT_EQ(calls, std::vector<uintptr_t>({1, 2, 3}));
+}
+
+TEST_F(DeferredExec, CancelAndExtend) {
+    deferred_token cancelled = defer_exec_advanced(table, TABLE_SIZE, 10, record_callback, (void *)1);
+    deferred_token extended  = defer_exec_advanced(table, TABLE_SIZE, 10, record_callback, (void *)2);
+    defer_exec_advanced(table, TABLE_SIZE, 15, record_callback, (void *)3);
+
+    EXPECT_TRUE(cancel_deferred_exec_advanced(table, TABLE_SIZE, cancelled));
+    EXPECT_FALSE(cancel_deferred_exec_advanced(table, TABLE_SIZE, cancelled));
+    EXPECT_TRUE(extend_deferred_exec_advanced(table, TABLE_SIZE, extended, 20));
+
+    run_for(20);
+    EXPECT_EQ(calls, std::vector<uintptr_t>({3, 2}));
+    EXPECT_FALSE(extend_deferred_exec_advanced(table, TABLE_SIZE, extended, 20));
+}
+
+TEST_F(DeferredExec, StaleTokenDoesNotMatchReusedSlot) {
+    deferred_token first = defer_exec_advanced(table, TABLE_SIZE, 10, record_callback, (void *)1);
+    EXPECT_TRUE(cancel_deferred_exec_advanced(table, TABLE_SIZE, first));
+
+    deferred_token second = defer_exec_advanced(table, TABLE_SIZE, 10, record_callback, (void *)2);
+    EXPECT_NE(first, second);
+    EXPECT_FALSE(cancel_deferred_exec_advanced(table, TABLE_SIZE, first));
+
+    run_for(10);
+    EXPECT_EQ(calls, std::vector<uintptr_t>({2}));
+}
+
+TEST_F(DeferredExec, TableFull) {
+    for (uintptr_t i = 0; i < TABLE_SIZE; i++) {
+        EXPECT_NE(defer_exec_advanced(table, TABLE_SIZE, 10 + i, record_callback, (void *)i), INVALID_DEFERRED_TOKEN);
+    }
+    EXPECT_EQ(defer_exec_advanced(table, TABLE_SIZE, 10, record_callback, NULL), INVALID_DEFERRED_TOKEN);
+
+    run_for(10);
+    EXPECT_NE(defer_exec_advanced(table, TABLE_SIZE, 10, record_callback, NULL), INVALID_DEFERRED_TOKEN);
+}
+
+TEST_F(DeferredExec, OverdueRepeatRunsOncePerTask) {
+    defer_exec_advanced(table, TABLE_SIZE, 1, repeat_callback, (void *)1);
+    defer_exec_advanced(table, TABLE_SIZE, 5, record_callback, (void *)2);
+
+    // Stall for a while, the repeating executor falls behind but must not starve the other one
+    advance_time(10);
+    deferred_exec_advanced_task(table, TABLE_SIZE, &last_exec);
+    EXPECT_EQ(calls, std::vector<uintptr_t>({1, 2}));
+    run_for(1);
+    EXPECT_EQ(calls, std::vector<uintptr_t>({1, 2, 1}));
+}
+
+TEST_F(DeferredExec, BasicApi) {
+    deferred_token tokens[MAX_DEFERRED_EXECUTORS];
+    for (uintptr_t i = 0; i < MAX_DEFERRED_EXECUTORS; i++) {
+        tokens[i] = defer_exec(MAX_DEFERRED_EXECUTORS - i, record_callback, (void *)i);
+        EXPECT_NE(tokens[i], INVALID_DEFERRED_TOKEN);
+    }
+    EXPECT_EQ(defer_exec(1, record_callback, NULL), INVALID_DEFERRED_TOKEN);
+    EXPECT_TRUE(cancel_deferred_exec(tokens[0]));
+
+    for (uint32_t i = 0; i < MAX_DEFERRED_EXECUTORS; i++) {
+        advance_time(1);
+        deferred_exec_task();
+    }
+    ASSERT_EQ(calls.size(), MAX_DEFERRED_EXECUTORS - 1);
+    for (uintptr_t i = 0; i < calls.size(); i++) {
+        EXPECT_EQ(calls[i], MAX_DEFERRED_EXECUTORS - 1 - i);
+    }
+}
@@ -0,0 +1,7 @@
+# Copyright 2023 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+AUTO_SHIFT_ENABLE = yes
+KEY_OVERRIDE_ENABLE = yes
+
+include tests/fuzz/fuzz_common/fuzz.mk
@@ -0,0 +1,23 @@
+# Copyright 2023 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+# Shared by the fuzz targets in tests/fuzz, included from their test.mk
+
+OPT_DEFS += -DPROCESS_RECORD_HANDLER_STATS -DACTION_TAPPING_STATS
+OPT_DEFS += -DFUZZ_CORPUS=\"$(TEST_PATH)/corpus\"
+
+SRC += tests/fuzz/fuzz_common/fuzz_fixture.cpp
+
+INTROSPECTION_KEYMAP_C = fuzz_keymap.c
+
+VPATH += $(TOP_DIR)/tests/fuzz/fuzz_common
+
+# FUZZ=yes builds a libFuzzer (or AFL++ in libFuzzer mode) executable instead of
+# the corpus regression test, this needs CC=clang
+ifeq ($(strip $(FUZZ)), yes)
+    FUZZ_ENGINE = libfuzzer
+    OPT_DEFS += -DFUZZING_BUILD_MODE_UNSAFE_FOR_PRODUCTION
+    CFLAGS += -fsanitize=fuzzer-no-link,address,undefined
+    CXXFLAGS += -fsanitize=fuzzer-no-link,address,undefined
+    LDFLAGS += -fsanitize=fuzzer,address,undefined
+endif
@@ -0,0 +1,156 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <dirent.h>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include "fuzz_fixture.hpp"
+
+extern "C" {
+#include "action_layer.h"
+#include "action_tapping.h"
+#include "action_util.h"
+#include "quantum.h"
+
+void advance_time(uint32_t ms);
+}
+
+using testing::_;
+using testing::Invoke;
+
+#ifdef FUZZING_BUILD_MODE_UNSAFE_FOR_PRODUCTION
+#    define FUZZ_CHECK(condition, message)                                    \
+        do {                                                                  \
+            if (!(condition)) {                                               \
+                std::cerr << "fuzz invariant failed: " << message << std::endl; \
+                abort();                                                      \
+            }                                                                 \
+        } while (0)
+#else
+#    define FUZZ_CHECK(condition, message) EXPECT_TRUE(condition) << message
+#endif
+
+#ifdef TAP_DANCE_ENABLE
+#    define FUZZ_KC_X TD(0)
+#else
+#    define FUZZ_KC_X KC_X
+#endif
+
+// Built on first use, the keycode names KeymapKey looks up aren't there during static initialisation.
+// Combo keys are transparent on layer 1: combos match on keycodes, so a combo key that changes
+// keycode while held is never released (a known limitation, see the combo docs).
+static const std::vector<KeymapKey>& fuzz_keymap() {
+    // clang-format off
+    static const std::vector<KeymapKey> keymap = {
+        KeymapKey(0, 0, 0, LSFT_T(KC_A)), KeymapKey(0, 1, 0, LCTL_T(KC_S)), KeymapKey(0, 2, 0, LT(1, KC_D)), KeymapKey(0, 3, 0, KC_F),    KeymapKey(0, 4, 0, KC_J),    KeymapKey(0, 5, 0, KC_K),
+        KeymapKey(0, 0, 1, KC_LSFT),      KeymapKey(0, 1, 1, FUZZ_KC_X),    KeymapKey(0, 2, 1, KC_C),        KeymapKey(0, 3, 1, KC_V),    KeymapKey(0, 4, 1, KC_SPC),  KeymapKey(0, 5, 1, KC_BSPC),
+
+        KeymapKey(1, 0, 0, KC_TRNS),      KeymapKey(1, 1, 0, KC_TRNS),      KeymapKey(1, 2, 0, KC_TRNS),     KeymapKey(1, 3, 0, KC_TRNS), KeymapKey(1, 4, 0, KC_TRNS), KeymapKey(1, 5, 0, KC_1),
+        KeymapKey(1, 0, 1, KC_TRNS),      KeymapKey(1, 1, 1, KC_TRNS),      KeymapKey(1, 2, 1, KC_TRNS),     KeymapKey(1, 3, 1, KC_TRNS), KeymapKey(1, 4, 1, KC_2),    KeymapKey(1, 5, 1, KC_3),
+    };
+    // clang-format on
+    return keymap;
+}
+
+static const size_t fuzz_key_count = 12;
+
+FuzzFixture::FuzzFixture() {
+    for (const KeymapKey& key : fuzz_keymap()) {
+        add_key(key);
+    }
+    ON_CALL(driver, send_keyboard_mock(_)).WillByDefault(Invoke([this](report_keyboard_t& report) { last_report = report; }));
+}
+
+void FuzzFixture::scan(unsigned loops) {
+    const uint32_t max_calls = FUZZ_MAX_CALLS_PER_HANDLER * process_record_handler_count();
+    for (unsigned i = 0; i < loops; i++) {
+        uint32_t calls = process_record_handler_calls;
+        keyboard_task();
+        advance_time(1);
+        FUZZ_CHECK(process_record_handler_calls - calls <= max_calls, "scan loop made " << process_record_handler_calls - calls << " handler calls");
+    }
+}
+
+void FuzzFixture::run_input(const uint8_t* data, size_t size) {
+    bool     pressed[fuzz_key_count] = {};
+    uint16_t overflows               = waiting_buffer_overflow_count();
+
+    for (size_t i = 0; i + 1 < size; i += 2) {
+        size_t           index = data[i] % fuzz_key_count;
+        const KeymapKey& key   = fuzz_keymap()[index];
+        pressed[index] ? release_key(key.position.col, key.position.row) : press_key(key.position.col, key.position.row);
+        pressed[index] = !pressed[index];
+
+        uint8_t delay = data[i + 1];
+        scan(delay < 200 ? delay : (delay - 199) * 20);
+    }
+
+    for (size_t index = 0; index < fuzz_key_count; index++) {
+        if (pressed[index]) {
+            release_key(fuzz_keymap()[index].position.col, fuzz_keymap()[index].position.row);
+            scan(1);
+        }
+    }
+    scan(FUZZ_SETTLE_TIME);
+
+    FUZZ_CHECK(waiting_buffer_overflow_count() == overflows, "waiting buffer overflowed");
+    FUZZ_CHECK(!action_tapping_pending(), "tap-hold decision still pending");
+    FUZZ_CHECK(!has_anykey(keyboard_report), "keys left in the keyboard report: " << *keyboard_report);
+    FUZZ_CHECK(get_mods() == 0 && get_weak_mods() == 0, "mods left active: " << +get_mods() << " weak " << +get_weak_mods());
+    FUZZ_CHECK(layer_state == 0, "layers left active: " << layer_state);
+    FUZZ_CHECK(!has_anykey(&last_report) && last_report.mods == 0, "last report sent to the host isn't empty: " << last_report);
+}
+
+#ifdef FUZZING_BUILD_MODE_UNSAFE_FOR_PRODUCTION
+
+static FuzzFixture* fixture;
+
+extern "C" int LLVMFuzzerInitialize(int* argc, char*** argv) {
+    TestFixture::SetUpTestCase();
+    fixture = new FuzzFixture();
+    return 0;
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+    fixture->run_input(data, size);
+    return 0;
+}
+
+#else
+
+class Fuzz : public FuzzFixture {
+   protected:
+    // Plays every file in `path` in name order, returns how many there were
+    size_t run_directory(const std::string& path) {
+        std::vector<std::string> files;
+        if (DIR* directory = opendir(path.c_str())) {
+            while (struct dirent* entry = readdir(directory)) {
+                if (entry->d_name[0] != '.') {
+                    files.push_back(path + "/" + entry->d_name);
+                }
+            }
+            closedir(directory);
+        }
+        std::sort(files.begin(), files.end());
+
+        for (const std::string& file : files) {
+            SCOPED_TRACE(file);
+            std::ifstream        stream(file, std::ios::binary);
+            std::vector<uint8_t> input((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+            run_input(input.data(), input.size());
+            if (HasFailure()) {
+                break;
+            }
+        }
+        return files.size();
+    }
+};
+
+TEST_F(Fuzz, Corpus) {
+    EXPECT_GT(run_directory(FUZZ_CORPUS), 0) << "no inputs in " FUZZ_CORPUS;
+}
+
+#endif
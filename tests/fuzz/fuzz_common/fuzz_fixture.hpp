@@ -0,0 +1,48 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "test_common.hpp"
+
+/* Scan loops of the final idle, long enough for every timeout to expire */
+#ifndef FUZZ_SETTLE_TIME
+#    define FUZZ_SETTLE_TIME 5000
+#endif
+
+/* Handler calls a single scan loop may make, per handler in process_record_quantum() */
+#ifndef FUZZ_MAX_CALLS_PER_HANDLER
+#    define FUZZ_MAX_CALLS_PER_HANDLER 64
+#endif
+
+/**
+ * @brief Plays fuzzer input as a timed stream of key events and checks the
+ * invariants of the action and tapping state machine.
+ *
+ * The input is read as pairs of bytes: the first selects one of the keys of
+ * the fuzz keymap and toggles it, the second is the number of scan loops to
+ * run afterwards (200 and above are long pauses, up to a second). Keys still
+ * down at the end are released, then the keyboard idles for FUZZ_SETTLE_TIME.
+ *
+ * Checked invariants:
+ *   - nothing is left pressed: no keys or mods in the report, no active layer
+ *     and no pending tap-hold decision,
+ *   - the waiting buffer never overflows,
+ *   - no scan loop makes more than FUZZ_MAX_CALLS_PER_HANDLER calls into each
+ *     process_record_quantum() handler.
+ */
+class FuzzFixture : public TestFixture {
+   public:
+    FuzzFixture();
+
+    void run_input(const uint8_t* data, size_t size);
+
+   private:
+    void TestBody() override {}
+    void scan(unsigned loops);
+
+    testing::NiceMock<TestDriver> driver;
+    report_keyboard_t             last_report = {};
+};
@@ -0,0 +1,35 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Feature definitions for the fuzz keymap, see fuzz_fixture.cpp for the key layout
+
+#include "quantum.h"
+
+#ifdef COMBO_ENABLE
+uint16_t const fj_combo[] = {KC_F, KC_J, COMBO_END};
+uint16_t const cv_combo[] = {KC_C, KC_V, COMBO_END};
+uint16_t const as_combo[] = {LSFT_T(KC_A), LCTL_T(KC_S), COMBO_END};
+
+combo_t key_combos[] = {
+    COMBO(fj_combo, KC_ESC),
+    COMBO(cv_combo, LALT_T(KC_TAB)),
+    COMBO(as_combo, KC_Q),
+};
+#endif
+
+#ifdef TAP_DANCE_ENABLE
+tap_dance_action_t tap_dance_actions[] = {
+    ACTION_TAP_DANCE_DOUBLE(KC_X, KC_Z),
+};
+#endif
+
+#ifdef KEY_OVERRIDE_ENABLE
+const key_override_t shift_backspace_override = ko_make_basic(MOD_MASK_SHIFT, KC_BSPC, KC_DEL);
+const key_override_t ctrl_j_override          = ko_make_basic(MOD_MASK_CTRL, KC_J, KC_DOWN);
+
+const key_override_t **key_overrides = (const key_override_t *[]){
+    &shift_backspace_override,
+    &ctrl_j_override,
+    NULL,
+};
+#endif
@@ -0,0 +1,7 @@
+# Copyright 2023 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+COMBO_ENABLE = yes
+TAP_DANCE_ENABLE = yes
+
+include tests/fuzz/fuzz_common/fuzz.mk
@@ -0,0 +1,9 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+// Small enough for a test to outgrow it
+#define KEY_OVERRIDE_INDEX_SIZE 4
@@ -0,0 +1,21 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "key_override_lists.h"
+
+// The ko_make_* initializers are C only, so the overrides live here
+static const key_override_t shift_bspc_del  = ko_make_basic(MOD_MASK_SHIFT, KC_BSPC, KC_DEL);
+static const key_override_t ctrl_a_x        = ko_make_basic(MOD_MASK_CTRL, KC_A, KC_X);
+static const key_override_t ctrl_a_y        = ko_make_basic(MOD_MASK_CTRL, KC_A, KC_Y);
+static const key_override_t ctrl_a_z_layer1 = ko_make_with_layers(MOD_MASK_CTRL, KC_A, KC_Z, 1 << 1);
+static const key_override_t ctrl_b_c        = ko_make_basic(MOD_MASK_CTRL, KC_B, KC_C);
+static const key_override_t shift_1_2       = ko_make_basic(MOD_MASK_SHIFT, KC_1, KC_2);
+static const key_override_t shift_3_4       = ko_make_basic(MOD_MASK_SHIFT, KC_3, KC_4);
+
+const key_override_t *basic_overrides[]          = {&ctrl_a_x, &shift_bspc_del, NULL};
+const key_override_t *shared_trigger_overrides[] = {&ctrl_b_c, &ctrl_a_y, &ctrl_a_x, NULL};
+const key_override_t *layer_overrides[]          = {&ctrl_a_z_layer1, &ctrl_a_x, NULL};
+const key_override_t *other_overrides[]          = {&ctrl_a_y, NULL};
+const key_override_t *unindexed_overrides[]      = {&shift_1_2, &shift_3_4, &ctrl_b_c, &ctrl_a_z_layer1, &ctrl_a_x, &shift_bspc_del, NULL};
+
+const key_override_t **key_overrides = NULL;
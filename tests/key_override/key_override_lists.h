@@ -0,0 +1,17 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "quantum.h"
+
+// shift + backspace = delete, ctrl + a = x
+extern const key_override_t *basic_overrides[];
+// ctrl + b = c, then ctrl + a = y listed before ctrl + a = x
+extern const key_override_t *shared_trigger_overrides[];
+// ctrl + a = z on layer 1 only, then ctrl + a = x
+extern const key_override_t *layer_overrides[];
+// ctrl + a = y
+extern const key_override_t *other_overrides[];
+// More overrides than KEY_OVERRIDE_INDEX_SIZE, ending with ctrl + a = x and shift + backspace = delete
+extern const key_override_t *unindexed_overrides[];
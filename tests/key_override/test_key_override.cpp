@@ -0,0 +1,83 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+using testing::_;
+using testing::InSequence;
+
+extern "C" {
+#include "key_override_lists.h"
+}
+
+class KeyOverride : public TestFixture {
+   protected:
+    KeymapKey shift = KeymapKey(0, 0, 0, KC_LSFT);
+    KeymapKey ctrl  = KeymapKey(0, 1, 0, KC_LCTL);
+    KeymapKey bspc  = KeymapKey(0, 2, 0, KC_BSPC);
+    KeymapKey a     = KeymapKey(0, 3, 0, KC_A);
+
+    void SetUp() override {
+        set_keymap({shift, ctrl, bspc, a});
+    }
+
+    /* Holds `mod` and taps `key`, expecting `replacement` to be sent instead of `key`. */
+    void tap_with_mod(TestDriver& driver, KeymapKey& mod, KeymapKey& key, uint16_t mod_keycode, uint16_t replacement) {
+        InSequence s;
+        EXPECT_REPORT(driver, (mod_keycode));
+        EXPECT_REPORT(driver, (replacement));
+        EXPECT_REPORT(driver, (mod_keycode));
+        EXPECT_EMPTY_REPORT(driver);
+        mod.press();
+        run_one_scan_loop();
+        key.press();
+        run_one_scan_loop();
+        key.release();
+        run_one_scan_loop();
+        mod.release();
+        run_one_scan_loop();
+        VERIFY_AND_CLEAR(driver);
+    }
+};
+
+TEST_F(KeyOverride, ReplacesTriggerWhileModsAreHeld) {
+    TestDriver driver;
+    key_overrides = basic_overrides;
+
+    tap_with_mod(driver, shift, bspc, KC_LSFT, KC_DEL);
+    tap_with_mod(driver, ctrl, a, KC_LCTL, KC_X);
+}
+
+TEST_F(KeyOverride, FirstListedOverrideWins) {
+    TestDriver driver;
+    key_overrides = shared_trigger_overrides;
+
+    tap_with_mod(driver, ctrl, a, KC_LCTL, KC_Y);
+}
+
+TEST_F(KeyOverride, SkipsOverridesForOtherLayers) {
+    TestDriver driver;
+    key_overrides = layer_overrides;
+
+    tap_with_mod(driver, ctrl, a, KC_LCTL, KC_X);
+}
+
+TEST_F(KeyOverride, PicksUpANewList) {
+    TestDriver driver;
+    key_overrides = layer_overrides;
+    tap_with_mod(driver, ctrl, a, KC_LCTL, KC_X);
+    key_overrides = other_overrides;
+    tap_with_mod(driver, ctrl, a, KC_LCTL, KC_Y);
+}
+
+TEST_F(KeyOverride, MoreOverridesThanTheIndexHolds) {
+    TestDriver driver;
+    key_overrides = unindexed_overrides;
+
+    tap_with_mod(driver, ctrl, a, KC_LCTL, KC_X);
+    tap_with_mod(driver, shift, bspc, KC_LSFT, KC_DEL);
+}
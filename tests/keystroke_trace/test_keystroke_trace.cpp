@@ -0,0 +1,162 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <vector>
+
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+extern "C" {
+#include "keystroke_trace.h"
+
+void set_time(uint32_t t);
+}
+
+using testing::_;
+using testing::Invoke;
+
+static std::vector<uint8_t> raw_hid_reply;
+
+extern "C" void raw_hid_send(uint8_t *data, uint8_t length) {
+    raw_hid_reply.assign(data, data + length);
+}
+
+class KeystrokeTrace : public TestFixture {
+   public:
+    void SetUp() override {
+        keystroke_trace_clear();
+        raw_hid_reply.clear();
+    }
+
+    std::vector<uint8_t> download() {
+        std::vector<uint8_t>     trace;
+        keystroke_trace_record_t record;
+        for (uint16_t i = 0; keystroke_trace_read(i, &record, 1); i++) {
+            const uint8_t *bytes = reinterpret_cast<const uint8_t *>(&record);
+            trace.insert(trace.end(), bytes, bytes + sizeof(record));
+        }
+        return trace;
+    }
+};
+
+TEST_F(KeystrokeTrace, RecordsKeyEvents) {
+    TestDriver driver;
+    auto       key_a = KeymapKey(0, 2, 1, KC_A);
+    set_keymap({key_a});
+
+    set_time(1000);
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_a, 30);
+    VERIFY_AND_CLEAR(driver);
+
+    keystroke_trace_record_t records[2];
+    ASSERT_EQ(keystroke_trace_count(), 2);
+    ASSERT_EQ(keystroke_trace_read(0, records, 2), 2);
+    EXPECT_EQ(records[0].time, 1000);
+    EXPECT_EQ(records[0].row, 1);
+    EXPECT_EQ(records[0].col, 2 | KEYSTROKE_TRACE_PRESSED);
+    EXPECT_EQ(records[1].time, 1030);
+    EXPECT_EQ(records[1].col, 2);
+
+    keyevent_t event = keystroke_trace_event(records[0]);
+    EXPECT_TRUE(IS_KEYEVENT(event));
+    EXPECT_TRUE(event.pressed);
+    EXPECT_EQ(event.key.col, 2);
+    EXPECT_EQ(event.time, 1000);
+}
+
+TEST_F(KeystrokeTrace, KeepsNewestRecords) {
+    TestDriver driver;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+    auto       key_b = KeymapKey(0, 1, 0, KC_B);
+    set_keymap({key_a, key_b});
+
+    EXPECT_ANY_REPORT(driver).Times(10);
+    for (int i = 0; i < 5; i++) {
+        tap_key(i % 2 ? key_b : key_a);
+    }
+    VERIFY_AND_CLEAR(driver);
+
+    // Ten events into a buffer of eight, the first tap is gone
+    keystroke_trace_record_t records[KEYSTROKE_TRACE_SIZE];
+    ASSERT_EQ(keystroke_trace_count(), KEYSTROKE_TRACE_SIZE);
+    ASSERT_EQ(keystroke_trace_read(0, records, KEYSTROKE_TRACE_SIZE), KEYSTROKE_TRACE_SIZE);
+    EXPECT_EQ(records[0].col, 1 | KEYSTROKE_TRACE_PRESSED);
+    EXPECT_EQ(records[7].col, 0);
+    EXPECT_EQ(keystroke_trace_read(6, records, KEYSTROKE_TRACE_SIZE), 2);
+    EXPECT_EQ(keystroke_trace_read(8, records, KEYSTROKE_TRACE_SIZE), 0);
+}
+
+TEST_F(KeystrokeTrace, RawHidDownload) {
+    TestDriver driver;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+    set_keymap({key_a});
+
+    EXPECT_ANY_REPORT(driver).Times(6);
+    tap_keys(key_a, key_a, key_a);
+    VERIFY_AND_CLEAR(driver);
+
+    uint8_t packet[32] = {KEYSTROKE_TRACE_RAW_HID_ID, KEYSTROKE_TRACE_READ, 4, 0};
+    ASSERT_TRUE(keystroke_trace_raw_hid_receive(packet, sizeof(packet)));
+    ASSERT_EQ(raw_hid_reply.size(), sizeof(packet));
+    EXPECT_EQ(raw_hid_reply[2], 6); // records in total
+    EXPECT_EQ(raw_hid_reply[4], 2); // records from offset 4
+    EXPECT_EQ(raw_hid_reply[5 + 3], KEYSTROKE_TRACE_PRESSED);
+    EXPECT_EQ(raw_hid_reply[5 + 4 + 3], 0);
+
+    uint8_t clear[32] = {KEYSTROKE_TRACE_RAW_HID_ID, KEYSTROKE_TRACE_CLEAR};
+    ASSERT_TRUE(keystroke_trace_raw_hid_receive(clear, sizeof(clear)));
+    EXPECT_EQ(keystroke_trace_count(), 0);
+
+    uint8_t other[32] = {0x01};
+    EXPECT_FALSE(keystroke_trace_raw_hid_receive(other, sizeof(other)));
+}
+
+TEST_F(KeystrokeTrace, ReplayReproducesTapHoldDecisions) {
+    auto mod_tap = KeymapKey(0, 0, 0, SFT_T(KC_A));
+    auto key_b   = KeymapKey(0, 1, 0, KC_B);
+    auto key_c   = KeymapKey(0, 2, 0, KC_C);
+    set_keymap({mod_tap, key_b, key_c});
+
+    std::vector<report_keyboard_t> recorded;
+    std::vector<report_keyboard_t> replayed;
+
+    {
+        testing::NiceMock<TestDriver> driver;
+        ON_CALL(driver, send_keyboard_mock(_)).WillByDefault(Invoke([&](report_keyboard_t &report) { recorded.push_back(report); }));
+
+        // A roll that resolves as a tap, then a hold past the tapping term
+        mod_tap.press();
+        idle_for(40);
+        key_b.press();
+        idle_for(20);
+        mod_tap.release();
+        idle_for(15);
+        key_b.release();
+        idle_for(100);
+        mod_tap.press();
+        idle_for(TAPPING_TERM + 10);
+        key_c.press();
+        idle_for(25);
+        key_c.release();
+        idle_for(5);
+        mod_tap.release();
+        idle_for(TAPPING_TERM);
+    }
+    std::vector<uint8_t> trace = download();
+    ASSERT_EQ(trace.size(), 8 * sizeof(keystroke_trace_record_t));
+
+    {
+        testing::NiceMock<TestDriver> driver;
+        ON_CALL(driver, send_keyboard_mock(_)).WillByDefault(Invoke([&](report_keyboard_t &report) { replayed.push_back(report); }));
+
+        replay_keystroke_trace(trace);
+        idle_for(TAPPING_TERM);
+    }
+
+    ASSERT_FALSE(recorded.empty());
+    EXPECT_EQ(replayed, recorded);
+    // The replay is itself recorded, with identical timestamps
+    EXPECT_EQ(download(), trace);
+}
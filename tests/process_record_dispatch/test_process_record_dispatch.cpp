@@ -0,0 +1,82 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+using testing::_;
+
+class ProcessRecordDispatch : public TestFixture {
+   protected:
+    void SetUp() override {
+        process_record_handler_calls = 0;
+    }
+};
+
+// A basic keycode only visits the handlers that need to see every key, where
+// the previous short-circuit chain visited every compiled-in handler.
+TEST_F(ProcessRecordDispatch, BasicKeycodeSkipsRangedHandlers) {
+    TestDriver driver;
+    KeymapKey  key_a = KeymapKey(0, 0, 0, KC_A);
+
+    set_keymap({key_a});
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_a);
+    VERIFY_AND_CLEAR(driver);
+
+    const uint32_t chain_calls = 2 * process_record_handler_count();
+    std::cout << "handler calls for a KC_A tap: " << process_record_handler_calls << " (chain: " << chain_calls << ")" << std::endl;
+    EXPECT_LT(process_record_handler_calls, chain_calls);
+}
+
+TEST_F(ProcessRecordDispatch, BenchmarkHandlerCallsPerEvent) {
+    TestDriver driver;
+    KeymapKey  key_a     = KeymapKey(0, 0, 0, KC_A);
+    KeymapKey  key_shift = KeymapKey(0, 1, 0, KC_LSFT);
+
+    set_keymap({key_a, key_shift});
+
+    EXPECT_REPORT(driver, (KC_LSFT)).Times(101);
+    EXPECT_REPORT(driver, (KC_LSFT, KC_A)).Times(100);
+    EXPECT_EMPTY_REPORT(driver);
+    key_shift.press();
+    run_one_scan_loop();
+    for (int i = 0; i < 100; i++) {
+        tap_key(key_a);
+    }
+    key_shift.release();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    const uint32_t events      = 2 * 100 + 2;
+    const uint32_t chain_calls = events * process_record_handler_count();
+    std::cout << "handler calls per event: " << (double)process_record_handler_calls / events << " (chain: " << (unsigned)process_record_handler_count() << ")" << std::endl;
+    EXPECT_LT(process_record_handler_calls, chain_calls);
+}
+
+// Feature keycodes still reach their ranged handlers.
+TEST_F(ProcessRecordDispatch, RangedHandlersStillRun) {
+    TestDriver driver;
+    KeymapKey  lower_key  = KeymapKey(0, 0, 0, QK_TRI_LAYER_LOWER);
+    KeymapKey  tapping_up = KeymapKey(0, 1, 0, QK_DYNAMIC_TAPPING_TERM_UP);
+
+    set_keymap({lower_key, tapping_up, KeymapKey(1, 1, 0, KC_TRNS)});
+
+    EXPECT_NO_REPORT(driver);
+    lower_key.press();
+    run_one_scan_loop();
+    EXPECT_TRUE(layer_state_is(get_tri_layer_lower_layer()));
+    lower_key.release();
+    run_one_scan_loop();
+    EXPECT_FALSE(layer_state_is(get_tri_layer_lower_layer()));
+    VERIFY_AND_CLEAR(driver);
+
+    const uint16_t tapping_term = g_tapping_term;
+    EXPECT_NO_REPORT(driver);
+    tap_key(tapping_up);
+    EXPECT_EQ(g_tapping_term, tapping_term + DYNAMIC_TAPPING_TERM_INCREMENT);
+    VERIFY_AND_CLEAR(driver);
+    g_tapping_term = tapping_term;
+}
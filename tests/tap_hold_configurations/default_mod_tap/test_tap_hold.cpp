@@ -102,6 +102,52 @@ TEST_F(DefaultTapHold, tap_a_mod_tap_key_while_another_mod_tap_key_is_held) {
     VERIFY_AND_CLEAR(driver);
 }
 
+TEST_F(DefaultTapHold, full_waiting_buffer_forces_hold_of_mod_tap_key) {
+    TestDriver driver;
+    InSequence s;
+    auto       mod_tap_hold_key = KeymapKey(0, 1, 0, SFT_T(KC_P));
+    auto       regular_keys     = std::vector<KeymapKey>{KeymapKey(0, 2, 0, KC_A), KeymapKey(0, 3, 0, KC_B), KeymapKey(0, 4, 0, KC_C), KeymapKey(0, 5, 0, KC_D), KeymapKey(0, 6, 0, KC_E)};
+
+    set_keymap({mod_tap_hold_key, regular_keys[0], regular_keys[1], regular_keys[2], regular_keys[3], regular_keys[4]});
+
+    /* Press mod-tap-hold key. */
+    EXPECT_NO_REPORT(driver);
+    mod_tap_hold_key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    /* Tap regular keys until the waiting buffer is full. */
+    EXPECT_NO_REPORT(driver);
+    for (size_t i = 0; i < WAITING_BUFFER_SIZE / 2; i++) {
+        tap_key(regular_keys[i]);
+    }
+    VERIFY_AND_CLEAR(driver);
+
+    /* Press one more key, the mod-tap key is settled as a hold instead of dropping everything. */
+    EXPECT_REPORT(driver, (KC_LSFT));
+    EXPECT_REPORT(driver, (KC_LSFT, KC_A));
+    EXPECT_REPORT(driver, (KC_LSFT));
+    EXPECT_REPORT(driver, (KC_LSFT, KC_B));
+    EXPECT_REPORT(driver, (KC_LSFT));
+    EXPECT_REPORT(driver, (KC_LSFT, KC_C));
+    EXPECT_REPORT(driver, (KC_LSFT));
+    EXPECT_REPORT(driver, (KC_LSFT, KC_D));
+    EXPECT_REPORT(driver, (KC_LSFT));
+    EXPECT_REPORT(driver, (KC_LSFT, KC_E));
+    regular_keys[4].press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    /* Release the last key and mod-tap-hold key. */
+    EXPECT_REPORT(driver, (KC_LSFT));
+    EXPECT_EMPTY_REPORT(driver);
+    regular_keys[4].release();
+    run_one_scan_loop();
+    mod_tap_hold_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
 TEST_F(DefaultTapHold, tap_regular_key_while_layer_tap_key_is_held) {
     TestDriver driver;
     InSequence s;
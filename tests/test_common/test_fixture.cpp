@@ -22,6 +22,7 @@ extern "C" {
 #include "debug.h"
 #include "eeconfig.h"
 #include "keyboard.h"
+#include "keystroke_trace.h"
 
 void set_time(uint32_t t);
 void advance_time(uint32_t ms);
@@ -179,6 +180,41 @@ void TestFixture::idle_for(unsigned time) {
     }
 }
 
+void TestFixture::replay_keystroke_trace(const std::vector<uint8_t>& trace) {
+    uint32_t now       = 0;
+    uint16_t last_time = 0;
+
+    test_logger.trace() << "replaying " << trace.size() / sizeof(keystroke_trace_record_t) << " keystroke trace records" << std::endl;
+    for (size_t i = 0; i + sizeof(keystroke_trace_record_t) <= trace.size(); i += sizeof(keystroke_trace_record_t)) {
+        keystroke_trace_record_t record = {.time = (uint16_t)(trace[i] | (trace[i + 1] << 8)), .row = trace[i + 2], .col = trace[i + 3]};
+        if (i == 0) {
+            set_time(record.time);
+            now = record.time;
+        } else {
+            now += (uint16_t)(record.time - last_time);
+        }
+        last_time = record.time;
+
+        // Scan up to the recorded time, so the event is picked up by the scan it was recorded in
+        while (timer_read32() < now) {
+            keyboard_task();
+            advance_time(1);
+        }
+
+        keyevent_t event = keystroke_trace_event(record);
+        if (IS_KEYEVENT(event)) {
+            if (event.pressed) {
+                press_key(event.key.col, event.key.row);
+            } else {
+                release_key(event.key.col, event.key.row);
+            }
+        } else {
+            action_exec(event);
+        }
+    }
+    run_one_scan_loop();
+}
+
 void TestFixture::print_test_log() const {
     const ::testing::TestInfo* const test_info = ::testing::UnitTest::GetInstance()->current_test_info();
     if (HasFailure()) {
@@ -19,6 +19,7 @@
 #include <cstdint>
 #include <unordered_map>
 #include <optional>
+#include <vector>
 #include "gtest/gtest.h"
 #include "keyboard.h"
 #include "test_keymap_key.hpp"
@@ -63,6 +64,15 @@ class TestFixture : public testing::Test {
     void run_one_scan_loop();
     void idle_for(unsigned ms);
 
+    /**
+     * @brief Replays a keystroke trace downloaded from a keyboard built with KEYSTROKE_TRACE_ENABLE,
+     * in its binary format of 4 bytes per record.
+     *
+     * The timer is set to the time of the first record and then advanced one scan loop at a time,
+     * so that every event reaches action_exec() with the time it was recorded at.
+     */
+    void replay_keystroke_trace(const std::vector<uint8_t>& trace);
+
     void expect_layer_state(layer_t layer) const;
 
    protected: